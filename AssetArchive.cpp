@@ -0,0 +1,108 @@
+#include "AssetArchive.hpp"
+#include <iostream>
+#include <cstring>
+
+const char AssetArchive::magic[4] = { 'J', 'E', 'P', 'K' };
+
+AssetArchive::AssetArchive() {}
+
+AssetArchive::~AssetArchive() {
+    Close();
+}
+
+bool AssetArchive::Open(const std::string& path) {
+    Close();
+
+    if (!file.Open(path)) {
+        return false;
+    }
+
+    if (!ReadIndex()) {
+        std::cerr << "Invalid asset archive: " << path << std::endl;
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::Close() {
+    entries.clear();
+    file.Close();
+}
+
+const Uint8* AssetArchive::Find(const std::string& path, std::size_t& size) const {
+    auto it = entries.find(NormalizePath(path));
+    if (it == entries.end()) {
+        size = 0;
+        return nullptr;
+    }
+
+    size = it->second.size;
+    return file.GetData() + it->second.offset;
+}
+
+SDL_RWops* AssetArchive::OpenRW(const std::string& path) const {
+    std::size_t size;
+    const Uint8* bytes = Find(path, size);
+    if (bytes == nullptr) {
+        return nullptr;
+    }
+    return SDL_RWFromConstMem(bytes, static_cast<int>(size));
+}
+
+std::string AssetArchive::NormalizePath(const std::string& path) {
+    std::string normalized = path;
+    for (char& c : normalized) {
+        if (c == '\\') {
+            c = '/';
+        }
+    }
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    return normalized;
+}
+
+bool AssetArchive::ReadIndex() {
+    const Uint8* data = file.GetData();
+    std::size_t dataSize = file.GetSize();
+    std::size_t cursor = 0;
+
+    auto readBytes = [&](void* out, std::size_t count) {
+        if (dataSize - cursor < count) {
+            return false;
+        }
+        std::memcpy(out, data + cursor, count);
+        cursor += count;
+        return true;
+    };
+
+    char header[sizeof(magic)];
+    Uint32 fileVersion = 0;
+    Uint32 count = 0;
+    if (!readBytes(header, sizeof(header)) || std::memcmp(header, magic, sizeof(magic)) != 0 ||
+        !readBytes(&fileVersion, sizeof(fileVersion)) || fileVersion != version ||
+        !readBytes(&count, sizeof(count))) {
+        return false;
+    }
+
+    entries.reserve(count);
+    for (Uint32 i = 0; i < count; i++) {
+        Uint32 pathLength = 0;
+        Uint64 offset = 0;
+        Uint64 size = 0;
+        if (!readBytes(&pathLength, sizeof(pathLength)) || dataSize - cursor < pathLength) {
+            return false;
+        }
+
+        std::string path(reinterpret_cast<const char*>(data + cursor), pathLength);
+        cursor += pathLength;
+
+        if (!readBytes(&offset, sizeof(offset)) || !readBytes(&size, sizeof(size)) ||
+            offset > dataSize || size > dataSize - offset) {
+            return false;
+        }
+        entries[path] = { static_cast<std::size_t>(offset), static_cast<std::size_t>(size) };
+    }
+    return true;
+}
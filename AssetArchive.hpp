@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <cstddef>
+#include "SDL2/SDL.h"
+#include "MappedFile.hpp"
+
+// Read-only view of an asset pack written by tools/pack_assets.cpp. The whole file is
+// memory-mapped and entries are handed to SDL as const memory streams, so nothing is copied.
+//
+// Layout (little-endian):
+//   char[4] "JEPK", Uint32 version, Uint32 entryCount
+//   entryCount x { Uint32 pathLength, char path[pathLength], Uint64 offset, Uint64 size }
+//   file data, each entry starting on a 16-byte boundary
+class AssetArchive {
+    public:
+        AssetArchive();
+        ~AssetArchive();
+
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const { return file.IsOpen(); }
+
+        const Uint8* Find(const std::string& path, std::size_t& size) const;
+        SDL_RWops* OpenRW(const std::string& path) const;
+
+        int GetEntryCount() const { return static_cast<int>(entries.size()); }
+        std::size_t GetMappedSize() const { return file.GetSize(); }
+
+        static std::string NormalizePath(const std::string& path);
+
+        static const char magic[4];
+        static const Uint32 version = 1;
+        static const std::size_t alignment = 16;
+
+    private:
+        struct Entry {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        bool ReadIndex();
+
+        std::unordered_map<std::string, Entry> entries;
+        MappedFile file;
+};
@@ -1,9 +1,26 @@
 #include "AssetManager.hpp"
 #include "ECS/Components.hpp"
+#include <set>
+#include <fstream>
+#include <algorithm>
 
 AssetManager::AssetManager(Manager* man) : manager(man), currentMusic("") {}
 
 AssetManager::~AssetManager() {
+    // Prefetched assets nobody claimed; the job system has been shut down by now, so their decodes are done.
+    for (auto& pending : pendingAssets) {
+        if (pending.surface != nullptr) {
+            SDL_FreeSurface(pending.surface);
+        }
+        if (pending.chunk != nullptr) {
+            Mix_FreeChunk(pending.chunk);
+        }
+        if (pending.mus != nullptr) {
+            Mix_FreeMusic(pending.mus);
+        }
+    }
+    pendingAssets.clear();
+
     for (auto& texture : textures) {
         if (texture.second != nullptr) {
             SDL_DestroyTexture(texture.second);
@@ -11,6 +28,11 @@ AssetManager::~AssetManager() {
     }
     textures.clear();
     
+    for (auto& atlas : glyphAtlases) {
+        delete atlas.second;
+    }
+    glyphAtlases.clear();
+    
     for (auto& font : fonts) {
         if (font.second != nullptr) {
             TTF_CloseFont(font.second);
@@ -52,28 +74,70 @@ void AssetManager::CreateObject(int posX, int posY, std::string id) {
 }
 
 void AssetManager::AddTexture(std::string id, const char* path) {
-    textures.emplace(id, TextureManager::LoadTexture(path));
+    SDL_Surface* surface = DecodeSurface(path);
+    if (!surface) {
+        printf("Failed to load texture '%s': %s\n", path, IMG_GetError());
+        return;
+    }
+    textures.emplace(id, TextureManager::UploadSurface(surface));
+    TrackBytes(PendingAsset::Texture, id, path);
 }
 
 SDL_Texture* AssetManager::GetTexture(std::string id) {
-    return textures[id];
+    auto it = textures.find(id);
+    if (it == textures.end()) {
+        TextureAtlas::Region region;
+        if (spriteAtlas.Find(id, region)) {
+            return region.texture;
+        }
+        return LoadOnDemand(PendingAsset::Texture, id) ? textures[id] : nullptr;
+    }
+    return it->second;
+}
+
+void AssetManager::GetTextureRegion(std::string id, SDL_Texture*& texture, SDL_Rect& region) {
+    TextureAtlas::Region atlasRegion;
+    if (spriteAtlas.Find(id, atlasRegion)) {
+        texture = atlasRegion.texture;
+        region = atlasRegion.rect;
+        return;
+    }
+
+    texture = GetTexture(id);
+    region = { 0, 0, 0, 0 };
+    if (texture != nullptr) {
+        SDL_QueryTexture(texture, nullptr, nullptr, &region.w, &region.h);
+    }
 }
 
 void AssetManager::AddFont(std::string id, std::string path, int fontSize) {
-    fonts.emplace(id, TTF_OpenFont(path.c_str(), fontSize));
+    SDL_RWops* rw = archive.OpenRW(path);
+    fonts.emplace(id, rw ? TTF_OpenFontRW(rw, 1, fontSize) : TTF_OpenFont(path.c_str(), fontSize));
 }
 
 TTF_Font* AssetManager::GetFont(std::string id) {
     return fonts[id];
 }
 
+GlyphAtlas* AssetManager::GetGlyphAtlas(std::string fontId) {
+    auto it = glyphAtlases.find(fontId);
+    if (it != glyphAtlases.end()) {
+        return it->second;
+    }
+
+    GlyphAtlas* atlas = new GlyphAtlas(GetFont(fontId), Game::renderer);
+    glyphAtlases.emplace(fontId, atlas);
+    return atlas;
+}
+
 void AssetManager::AddSound(std::string id, const char* path) {
-    Mix_Chunk* chunk = Mix_LoadWAV(path);
+    Mix_Chunk* chunk = DecodeSound(path);
     if (!chunk) {
         printf("Failed to load sound effect: %s\n", Mix_GetError());
         return;
     }
     sounds.emplace(id, chunk);
+    TrackBytes(PendingAsset::Sound, id, path);
 }
 
 Mix_Chunk* AssetManager::GetSound(std::string id) {
@@ -94,7 +158,7 @@ void AssetManager::PlaySound(std::string id, int volume) {
 }
 
 void AssetManager::AddMusic(std::string id, const char* path) {
-    Mix_Music* mus = Mix_LoadMUS(path);
+    Mix_Music* mus = DecodeMusic(path);
     
     if (!mus) {
         printf("Failed to load music file '%s': %s\n", path, Mix_GetError());
@@ -105,12 +169,16 @@ void AssetManager::AddMusic(std::string id, const char* path) {
     }
     
     music.emplace(id, mus);
+    TrackBytes(PendingAsset::Music, id, path);
     printf("Successfully loaded music: %s\n", id.c_str());
 }
 
 Mix_Music* AssetManager::GetMusic(std::string id) {
     auto it = music.find(id);
     if (it == music.end()) {
+        if (LoadOnDemand(PendingAsset::Music, id)) {
+            return music[id];
+        }
         printf("Music not found: %s\n", id.c_str());
         return nullptr;
     }
@@ -172,6 +240,349 @@ void AssetManager::ResumeMusic() {
     }
 }
 
+void AssetManager::QueueTexture(std::string id, const char* path) {
+    pendingAssets.emplace_back(PendingAsset::Texture, id, path);
+}
+
+void AssetManager::QueueAtlasTexture(std::string id, const char* path) {
+    pendingAssets.emplace_back(PendingAsset::Texture, id, path);
+    pendingAssets.back().atlased = true;
+}
+
+void AssetManager::QueueSound(std::string id, const char* path) {
+    pendingAssets.emplace_back(PendingAsset::Sound, id, path);
+}
+
+void AssetManager::QueueMusic(std::string id, const char* path) {
+    pendingAssets.emplace_back(PendingAsset::Music, id, path);
+}
+
+void AssetManager::SubmitQueued(JobSystem& jobs) {
+    // pendingAssets is a deque that only grows until LoadQueued drains it, so jobs can hold pointers into it.
+    for (auto& pending : pendingAssets) {
+        if (pending.handle.IsValid()) {
+            continue;
+        }
+
+        PendingAsset* asset = &pending;
+        asset->handle = jobs.Submit([this, asset]() {
+            switch (asset->kind) {
+                case PendingAsset::Texture:
+                    asset->surface = DecodeSurface(asset->path);
+                    break;
+                case PendingAsset::Sound:
+                    asset->chunk = DecodeSound(asset->path);
+                    break;
+                case PendingAsset::Music:
+                    asset->mus = DecodeMusic(asset->path);
+                    break;
+            }
+            if (asset->surface == nullptr && asset->chunk == nullptr && asset->mus == nullptr) {
+                asset->error = SDL_GetError();
+            }
+        });
+    }
+}
+
+void AssetManager::LoadQueued(JobSystem& jobs, const LoadProgress& onProgress) {
+    int total = static_cast<int>(pendingAssets.size());
+    SubmitQueued(jobs);
+
+    std::vector<bool> finished(total, false);
+    int loaded = 0;
+    if (onProgress) {
+        onProgress(loaded, total);
+    }
+
+    while (loaded < total) {
+        bool progressed = false;
+        for (int i = 0; i < total; i++) {
+            if (finished[i] || !pendingAssets[i].handle.IsDone()) {
+                continue;
+            }
+
+            FinishAsset(pendingAssets[i]);
+            finished[i] = true;
+            loaded++;
+            progressed = true;
+            if (onProgress) {
+                onProgress(loaded, total);
+            }
+        }
+
+        // Help decode instead of idling while the workers are busy.
+        if (!progressed && !jobs.RunPending()) {
+            SDL_Delay(1);
+        }
+    }
+
+    pendingAssets.clear();
+
+    if (spriteAtlas.HasPending()) {
+        int firstPage = spriteAtlas.GetPageCount();
+        spriteAtlas.Build();
+        for (int i = firstPage; i < spriteAtlas.GetPageCount(); i++) {
+            int w = 0;
+            int h = 0;
+            SDL_Texture* page = spriteAtlas.GetPage(i);
+            if (page != nullptr && SDL_QueryTexture(page, nullptr, nullptr, &w, &h) == 0) {
+                assetBytes[AssetKey(PendingAsset::Texture, "atlas page " + std::to_string(i))] = static_cast<std::size_t>(w) * h * 4;
+            }
+        }
+    }
+}
+
+void AssetManager::FinishAsset(PendingAsset& asset) {
+    switch (asset.kind) {
+        case PendingAsset::Texture:
+            if (!asset.surface) {
+                printf("Failed to load texture '%s': %s\n", asset.path.c_str(), asset.error.c_str());
+                return;
+            }
+            if (asset.atlased) {
+                spriteAtlas.Add(asset.id, asset.surface);
+                break;
+            }
+            textures.emplace(asset.id, TextureManager::UploadSurface(asset.surface));
+            TrackBytes(asset.kind, asset.id, asset.path);
+            break;
+
+        case PendingAsset::Sound:
+            if (!asset.chunk) {
+                printf("Failed to load sound effect: %s\n", asset.error.c_str());
+                return;
+            }
+            sounds.emplace(asset.id, asset.chunk);
+            TrackBytes(asset.kind, asset.id, asset.path);
+            break;
+
+        case PendingAsset::Music:
+            if (!asset.mus) {
+                printf("Failed to load music file '%s': %s\n", asset.path.c_str(), asset.error.c_str());
+                printf("Creating silent placeholder music instead\n");
+                music.emplace(asset.id, nullptr);
+                return;
+            }
+            music.emplace(asset.id, asset.mus);
+            TrackBytes(asset.kind, asset.id, asset.path);
+            printf("Successfully loaded music: %s\n", asset.id.c_str());
+            break;
+    }
+}
+
+bool AssetManager::MountArchive(const std::string& path) {
+    if (!archive.Open(path)) {
+        return false;
+    }
+    std::cout << "Mounted " << path << ": " << archive.GetEntryCount() << " files, "
+              << archive.GetMappedSize() << " bytes mapped" << std::endl;
+    return true;
+}
+
+SDL_Surface* AssetManager::DecodeSurface(const std::string& path) const {
+    SDL_RWops* rw = archive.OpenRW(path);
+    return rw ? IMG_Load_RW(rw, 1) : IMG_Load(path.c_str());
+}
+
+Mix_Chunk* AssetManager::DecodeSound(const std::string& path) const {
+    SDL_RWops* rw = archive.OpenRW(path);
+    return rw ? Mix_LoadWAV_RW(rw, 1) : Mix_LoadWAV(path.c_str());
+}
+
+Mix_Music* AssetManager::DecodeMusic(const std::string& path) const {
+    SDL_RWops* rw = archive.OpenRW(path);
+    return rw ? Mix_LoadMUS_RW(rw, 1) : Mix_LoadMUS(path.c_str());
+}
+
+void AssetManager::DeclareTexture(std::string id, const char* path, int level) {
+    AssetKey key(PendingAsset::Texture, id);
+    levelAssets[key].path = path;
+    levelManifests[level].push_back(key);
+}
+
+void AssetManager::DeclareMusic(std::string id, const char* path, int level) {
+    AssetKey key(PendingAsset::Music, id);
+    levelAssets[key].path = path;
+    levelManifests[level].push_back(key);
+}
+
+void AssetManager::UseLevel(int level, JobSystem& jobs) {
+    if (level == activeLevel) {
+        return;
+    }
+
+    // Acquire the new level before releasing the old one so assets they share are never dropped.
+    for (const AssetKey& key : levelManifests[level]) {
+        levelAssets[key].refCount++;
+    }
+    PrefetchLevel(level, jobs);
+    LoadQueued(jobs, nullptr);
+
+    for (const AssetKey& key : levelManifests[activeLevel]) {
+        Residency& residency = levelAssets[key];
+        residency.refCount--;
+        residency.lastUsed = ++releaseCounter;
+    }
+    activeLevel = level;
+
+    EnforceBudget();
+    PrintMemoryReport();
+}
+
+void AssetManager::PrefetchLevel(int level, JobSystem& jobs) {
+    for (const AssetKey& key : levelManifests[level]) {
+        if (IsResident(key) || IsPending(key)) {
+            continue;
+        }
+        pendingAssets.emplace_back(static_cast<PendingAsset::Kind>(key.first), key.second, levelAssets[key].path);
+    }
+    SubmitQueued(jobs);
+}
+
+bool AssetManager::IsPending(const AssetKey& key) const {
+    for (const auto& pending : pendingAssets) {
+        if (pending.kind == key.first && pending.id == key.second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t AssetManager::GetResidentBytes() const {
+    std::size_t total = 0;
+    for (const auto& entry : assetBytes) {
+        total += entry.second;
+    }
+    return total;
+}
+
+void AssetManager::PrintMemoryReport() const {
+    std::size_t bytes[3] = { 0, 0, 0 };
+    int counts[3] = { 0, 0, 0 };
+    for (const auto& entry : assetBytes) {
+        bytes[entry.first.first] += entry.second;
+        counts[entry.first.first]++;
+    }
+
+    printf("Assets resident for level %d: %d textures %d KB, %d sounds %d KB, %d music tracks %d KB, total %d KB of %d KB budget\n",
+           activeLevel,
+           counts[PendingAsset::Texture], static_cast<int>(bytes[PendingAsset::Texture] / 1024),
+           counts[PendingAsset::Sound], static_cast<int>(bytes[PendingAsset::Sound] / 1024),
+           counts[PendingAsset::Music], static_cast<int>(bytes[PendingAsset::Music] / 1024),
+           static_cast<int>(GetResidentBytes() / 1024), static_cast<int>(memoryBudget / 1024));
+}
+
+void AssetManager::TrackBytes(PendingAsset::Kind kind, const std::string& id, const std::string& path) {
+    std::size_t bytes = 0;
+    switch (kind) {
+        case PendingAsset::Texture: {
+            int w = 0;
+            int h = 0;
+            if (textures[id] != nullptr && SDL_QueryTexture(textures[id], nullptr, nullptr, &w, &h) == 0) {
+                bytes = static_cast<std::size_t>(w) * h * 4;
+            }
+            break;
+        }
+        case PendingAsset::Sound:
+            bytes = sounds[id] != nullptr ? sounds[id]->alen : 0;
+            break;
+        case PendingAsset::Music:
+            // Music streams from its source, so the encoded size is what stays resident.
+            bytes = SourceSize(path);
+            break;
+    }
+    assetBytes[AssetKey(kind, id)] = bytes;
+}
+
+bool AssetManager::IsResident(const AssetKey& key) const {
+    switch (key.first) {
+        case PendingAsset::Texture:
+            return textures.count(key.second) > 0;
+        case PendingAsset::Sound:
+            return sounds.count(key.second) > 0;
+        default:
+            return music.count(key.second) > 0;
+    }
+}
+
+bool AssetManager::LoadOnDemand(PendingAsset::Kind kind, const std::string& id) {
+    auto it = levelAssets.find(AssetKey(kind, id));
+    if (it == levelAssets.end()) {
+        return false;
+    }
+
+    printf("Loading %s on demand outside its level\n", id.c_str());
+    if (kind == PendingAsset::Texture) {
+        AddTexture(id, it->second.path.c_str());
+    } else {
+        AddMusic(id, it->second.path.c_str());
+    }
+    it->second.lastUsed = ++releaseCounter;
+    return IsResident(it->first);
+}
+
+void AssetManager::EnforceBudget() {
+    if (memoryBudget == 0 || GetResidentBytes() <= memoryBudget) {
+        return;
+    }
+
+    // Sprites cache their texture pointer, so anything a live sprite still draws is kept.
+    std::set<std::string> texturesInUse;
+    manager->view<SpriteComponent>().each([&](Entity&, SpriteComponent& sprite) {
+        texturesInUse.insert(sprite.getTexID());
+    });
+
+    std::vector<std::pair<Uint64, AssetKey>> candidates;
+    for (const auto& entry : levelAssets) {
+        const AssetKey& key = entry.first;
+        if (entry.second.refCount > 0 || !IsResident(key)) {
+            continue;
+        }
+        if (key.first == PendingAsset::Texture && texturesInUse.count(key.second) > 0) {
+            continue;
+        }
+        if (key.first == PendingAsset::Music && key.second == currentMusic) {
+            continue;
+        }
+        candidates.push_back({ entry.second.lastUsed, key });
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const auto& candidate : candidates) {
+        if (GetResidentBytes() <= memoryBudget) {
+            break;
+        }
+        Evict(candidate.second);
+    }
+}
+
+void AssetManager::Evict(const AssetKey& key) {
+    printf("Evicting %s (%d KB)\n", key.second.c_str(), static_cast<int>(assetBytes[key] / 1024));
+
+    if (key.first == PendingAsset::Texture) {
+        if (textures[key.second] != nullptr) {
+            SDL_DestroyTexture(textures[key.second]);
+        }
+        textures.erase(key.second);
+    } else if (key.first == PendingAsset::Music) {
+        if (music[key.second] != nullptr) {
+            Mix_FreeMusic(music[key.second]);
+        }
+        music.erase(key.second);
+    }
+    assetBytes.erase(key);
+}
+
+std::size_t AssetManager::SourceSize(const std::string& path) const {
+    std::size_t size = 0;
+    if (archive.Find(path, size) != nullptr) {
+        return size;
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<std::size_t>(file.tellg()) : 0;
+}
+
 void AssetManager::SetMasterVolume(int volume) {
     int scaledVolume = (volume * MIX_MAX_VOLUME) / 100;
     
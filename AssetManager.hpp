@@ -2,9 +2,17 @@
 
 #include <map>
 #include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <utility>
 #include "TextureManager.hpp"
 #include "Vector2D.hpp"
 #include "ECS/ECS.hpp"
+#include "GlyphAtlas.hpp"
+#include "TextureAtlas.hpp"
+#include "JobSystem.hpp"
+#include "AssetArchive.hpp"
 #include "src/include/SDL2/SDL_ttf.h"
 #include "src/include/SDL2/SDL_mixer.h"
 
@@ -18,9 +26,12 @@ class AssetManager {
         void CreateObject(int x, int y, std::string id);
         void AddTexture(std::string id, const char* path);
         SDL_Texture* GetTexture(std::string id);
+        // Atlased textures share a page, so their frames must be offset by the region's origin.
+        void GetTextureRegion(std::string id, SDL_Texture*& texture, SDL_Rect& region);
 
         void AddFont(std::string id, std::string path, int fontSize);
         TTF_Font* GetFont(std::string id);
+        GlyphAtlas* GetGlyphAtlas(std::string fontId);
         
         void AddSound(std::string id, const char* path);
         Mix_Chunk* GetSound(std::string id);
@@ -34,13 +45,88 @@ class AssetManager {
         void ResumeMusic();
         
         void SetMasterVolume(int volume);
+
+        // Once an archive is mounted, every load below reads packed entries straight from the
+        // mapping and only falls back to loose files for paths the archive does not contain.
+        bool MountArchive(const std::string& path);
+        const AssetArchive& GetArchive() const { return archive; }
+
+        // Level assets are declared up front but only loaded while a level listing them is in use.
+        // Released assets stay cached until the resident total goes over the memory budget.
+        void DeclareTexture(std::string id, const char* path, int level);
+        void DeclareMusic(std::string id, const char* path, int level);
+        void UseLevel(int level, JobSystem& jobs);
+        // Starts decoding a level's missing assets in the background; the next UseLevel uploads them.
+        void PrefetchLevel(int level, JobSystem& jobs);
+        void SetMemoryBudget(std::size_t bytes) { memoryBudget = bytes; }
+        std::size_t GetResidentBytes() const;
+        void PrintMemoryReport() const;
+
+        // Queued assets are decoded on the job system by LoadQueued; only texture uploads
+        // and the progress callback run on the calling (render) thread.
+        using LoadProgress = std::function<void(int loaded, int total)>;
+        void QueueTexture(std::string id, const char* path);
+        void QueueAtlasTexture(std::string id, const char* path);
+        void QueueSound(std::string id, const char* path);
+        void QueueMusic(std::string id, const char* path);
+        void LoadQueued(JobSystem& jobs, const LoadProgress& onProgress);
     
     private:
+        struct PendingAsset {
+            enum Kind { Texture, Sound, Music };
+
+            PendingAsset(Kind kind, std::string id, std::string path)
+                : kind(kind), id(std::move(id)), path(std::move(path)) {}
+
+            Kind kind;
+            std::string id;
+            std::string path;
+            SDL_Surface* surface = nullptr;
+            Mix_Chunk* chunk = nullptr;
+            Mix_Music* mus = nullptr;
+            std::string error;
+            JobHandle handle;
+            bool atlased = false;
+        };
+
+        using AssetKey = std::pair<int, std::string>;
+
+        struct Residency {
+            std::string path;
+            int refCount = 0;
+            Uint64 lastUsed = 0;
+        };
+
+        void SubmitQueued(JobSystem& jobs);
+        void FinishAsset(PendingAsset& asset);
+        void TrackBytes(PendingAsset::Kind kind, const std::string& id, const std::string& path);
+        bool IsResident(const AssetKey& key) const;
+        bool IsPending(const AssetKey& key) const;
+        bool LoadOnDemand(PendingAsset::Kind kind, const std::string& id);
+        void EnforceBudget();
+        void Evict(const AssetKey& key);
+        std::size_t SourceSize(const std::string& path) const;
+        SDL_Surface* DecodeSurface(const std::string& path) const;
+        Mix_Chunk* DecodeSound(const std::string& path) const;
+        Mix_Music* DecodeMusic(const std::string& path) const;
 
         Manager* manager;
         std::map<std::string, SDL_Texture*> textures;
         std::map<std::string, TTF_Font*> fonts;
+        std::map<std::string, GlyphAtlas*> glyphAtlases;
         std::map<std::string, Mix_Chunk*> sounds;
         std::map<std::string, Mix_Music*> music;
         std::string currentMusic;
+        std::deque<PendingAsset> pendingAssets;
+        AssetArchive archive;
+        TextureAtlas spriteAtlas{atlasPageSize};
+
+        static const int atlasPageSize = 1024;
+
+        std::map<AssetKey, Residency> levelAssets;
+        std::map<int, std::vector<AssetKey>> levelManifests;
+        std::map<AssetKey, std::size_t> assetBytes;
+        int activeLevel = 0;
+        std::size_t memoryBudget = 0;
+        Uint64 releaseCounter = 0;
 };
\ No newline at end of file
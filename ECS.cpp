@@ -3,4 +3,27 @@
 void Entity::addGroup(Group mGroup) {
     groupBitSet[mGroup] = true;
     manager.AddToGroup(this, mGroup);
-}
\ No newline at end of file
+}
+
+void Entity::delGroup(Group mGroup) {
+    groupBitSet[mGroup] = false;
+    manager.queueRefresh(this);
+}
+
+void Entity::destroy() {
+    if (!active) {
+        return;
+    }
+    active = false;
+    manager.queueRefresh(this);
+}
+
+void Entity::releaseComponents() {
+    for (ComponentID id = 0; id < maxComponents; id++) {
+        if (componentBitSet[id]) {
+            manager.destroyComponent(id, index);
+        }
+    }
+    components.clear();
+    componentBitSet.reset();
+}
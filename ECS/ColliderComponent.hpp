@@ -13,7 +13,6 @@ class ColliderComponent : public Component {
     int offsetX = 0;
     int offsetY = 0;
 
-    SDL_Texture* tex;
     SDL_Rect srcR, destR;
 
     TransformComponent* transform;
@@ -23,7 +22,6 @@ class ColliderComponent : public Component {
         collider.w = collider.h = 0;
         offsetX = 0;
         offsetY = 0;
-        tex = nullptr;
     }
 
     ColliderComponent(std::string t, int xpos, int ypos, int size) {
@@ -32,7 +30,6 @@ class ColliderComponent : public Component {
         collider.y = ypos;
         collider.w = size;
         collider.h = size;
-        tex = nullptr;
     }
 
     ColliderComponent(std::string t, int w, int h, int offX, int offY) {
@@ -41,14 +38,6 @@ class ColliderComponent : public Component {
         collider.h = h;
         offsetX = offX;
         offsetY = offY;
-        tex = nullptr;
-    }
-
-    ~ColliderComponent() {
-        if (tex != nullptr) {
-            SDL_DestroyTexture(tex);
-            tex = nullptr;
-        }
     }
 
     void init() override {
@@ -69,7 +58,6 @@ class ColliderComponent : public Component {
             collider.y = static_cast<int>(transform->position.y) + offsetY;
         }
 
-        tex = TextureManager::LoadTexture("assets/colliderTex.png");
         srcR = { 0, 0, 32, 32};
         destR = { collider.x, collider.y, collider.w, collider.h };
     }
@@ -87,6 +75,15 @@ class ColliderComponent : public Component {
     }
 
     void draw() override {
-        // TextureManager::Draw(tex, srcR, destR, SDL_FLIP_NONE);
+        if (!Game::debugColliders) {
+            return;
+        }
+
+        SDL_Texture* tex = Game::assets->GetTexture("collider");
+        if (Game::spriteBatch.IsRecording()) {
+            Game::spriteBatch.AddOverlay(tex, srcR, destR);
+        } else if (tex != nullptr) {
+            TextureManager::Draw(tex, srcR, destR, SDL_FLIP_NONE);
+        }
     }
 };
\ No newline at end of file
@@ -6,41 +6,129 @@
 #include <algorithm>
 #include <bitset>
 #include <array>
+#include <new>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include "../JobSystem.hpp"
+#include <utility>
 
 class Component;
 class Entity;
 class Manager;
 
-class System {
-    public:
-        virtual void update() = 0;
-        virtual ~System() = default;
-};
-
 using ComponentID = std::size_t;
 using Group = std::size_t;
 
-inline ComponentID getNewComponentTypeID() {
-    static ComponentID lastID = 0u;
-    return lastID++;
-}
+class TransformComponent;
+class SpriteComponent;
+class ColliderComponent;
+class TileComponent;
+class AmmoComponent;
+class ProjectileComponent;
+class UILabel;
+class HealthComponent;
+class KeyboardController;
+class ObjectComponent;
+class EnemyAIComponent;
+
+template <typename... Ts> struct ComponentList {};
+
+// Every component type is registered here and its ID is its position in the list, fixed at
+// compile time. Append new types at the end so IDs already written to disk keep their meaning.
+using RegisteredComponents = ComponentList<
+    TransformComponent,
+    SpriteComponent,
+    ColliderComponent,
+    TileComponent,
+    AmmoComponent,
+    ProjectileComponent,
+    UILabel,
+    HealthComponent,
+    KeyboardController,
+    ObjectComponent,
+    EnemyAIComponent
+>;
+
+template <typename T, typename List> struct ComponentIndex;
+
+template <typename T, typename... Ts>
+struct ComponentIndex<T, ComponentList<T, Ts...>> {
+    static constexpr ComponentID value = 0;
+};
 
-template <typename T> inline ComponentID getComponentTypeID() noexcept { 
-    static ComponentID typeID = getNewComponentTypeID();
-    return typeID;
+template <typename T, typename U, typename... Ts>
+struct ComponentIndex<T, ComponentList<U, Ts...>> {
+    static constexpr ComponentID value = 1 + ComponentIndex<T, ComponentList<Ts...>>::value;
+};
+
+template <typename T>
+struct ComponentIndex<T, ComponentList<>> {
+    static_assert(sizeof(T) == 0, "Component type is not listed in RegisteredComponents");
+};
+
+template <typename... Ts>
+constexpr std::size_t componentListSize(ComponentList<Ts...>) { return sizeof...(Ts); }
+
+constexpr std::size_t registeredComponentCount = componentListSize(RegisteredComponents{});
+
+template <typename T>
+constexpr ComponentID componentTypeID = ComponentIndex<T, RegisteredComponents>::value;
+
+template <typename T> constexpr ComponentID getComponentTypeID() noexcept {
+    return componentTypeID<T>;
 }
 
 constexpr std::size_t maxComponents = 32;
 constexpr std::size_t maxGroups = 32;
 
+static_assert(registeredComponentCount <= maxComponents, "Too many registered components for ComponentBitSet");
+
 using ComponentBitSet = std::bitset<maxComponents>;
 using GroupBitSet = std::bitset<maxGroups>;
 
+template <typename... Ts>
+constexpr unsigned long long componentMaskBits = (0ull | ... | (1ull << componentTypeID<Ts>));
+
+template <typename... Ts>
+constexpr ComponentBitSet componentMask{ componentMaskBits<Ts...> };
+
 using ComponentArray = std::array<Component*, maxComponents>;
 
+// A system declares the component types it reads and writes so the Manager can run
+// systems with disjoint access on different threads. Types listed with drive<T>()
+// have their per-entity Component::update() driven by the system instead of Entity::update().
+class System {
+    public:
+        virtual void update() = 0;
+        // Runs on the main thread after every system has finished; structural changes go here.
+        virtual void sync() {}
+        virtual ~System() = default;
+
+        bool conflictsWith(const System& other) const {
+            return (writes & (other.reads | other.writes)).any() || (other.writes & reads).any();
+        }
+
+        ComponentBitSet reads;
+        ComponentBitSet writes;
+        ComponentBitSet driven;
+
+    protected:
+        template <typename T> void read() { reads |= componentMask<T>; }
+        template <typename T> void write() { writes |= componentMask<T>; }
+        template <typename T> void drive() {
+            write<T>();
+            driven |= componentMask<T>;
+        }
+};
+
 class Component {
     public:
         Entity* entity;
+        ComponentID typeID = 0;
 
         virtual void init() {}
         virtual void update() {}
@@ -49,55 +137,138 @@ class Component {
         virtual ~Component() {}
 };
 
+class ComponentPoolBase {
+    public:
+        virtual void destroy(std::size_t index) = 0;
+        virtual ~ComponentPoolBase() {}
+};
+
+// Components of one type live in fixed-size pages indexed by entity slot, so they are
+// contiguous per type and never move once constructed (components keep pointers to each other).
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+    public:
+        static constexpr std::size_t pageSize = 64;
+
+        ~ComponentPool() {
+            while (!owners.empty()) {
+                destroy(owners.back());
+            }
+        }
+
+        template <typename... TArgs>
+        T* emplace(std::size_t index, TArgs&&... mArgs) {
+            while (pages.size() <= index / pageSize) {
+                pages.emplace_back(new Page());
+            }
+            if (slots.size() <= index) {
+                slots.resize(index + 1, npos);
+            }
+
+            T* c = new (slotAddress(index)) T(std::forward<TArgs>(mArgs)...);
+            slots[index] = owners.size();
+            owners.push_back(index);
+            return c;
+        }
+
+        T* get(std::size_t index) {
+            return reinterpret_cast<T*>(slotAddress(index));
+        }
+
+        bool has(std::size_t index) const {
+            return index < slots.size() && slots[index] != npos;
+        }
+
+        void destroy(std::size_t index) override {
+            if (!has(index)) {
+                return;
+            }
+
+            get(index)->~T();
+
+            std::size_t position = slots[index];
+            std::size_t last = owners.back();
+            owners[position] = last;
+            slots[last] = position;
+            owners.pop_back();
+            slots[index] = npos;
+        }
+
+        const std::vector<std::size_t>& indices() const { return owners; }
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        struct Page {
+            alignas(T) unsigned char storage[pageSize * sizeof(T)];
+        };
+
+        unsigned char* slotAddress(std::size_t index) {
+            return pages[index / pageSize]->storage + (index % pageSize) * sizeof(T);
+        }
+
+        std::vector<std::unique_ptr<Page>> pages;
+        std::vector<std::size_t> slots;
+        std::vector<std::size_t> owners;
+};
+
+struct EntityHandle {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
 class Entity {
+    friend class Manager;
+
     private:
         Manager& manager;
+        std::size_t index;
+        std::uint32_t generation = 0;
+        std::size_t listPosition = 0;
         bool active = true;
-        std::vector<std::unique_ptr<Component>> components;
+        bool pendingRefresh = false;
+        std::vector<Component*> components;
 
         ComponentArray componentArray;
         ComponentBitSet componentBitSet;
         GroupBitSet groupBitSet;
     public:
-        Entity(Manager& mManager) : manager(mManager) {}
-        void update() {
-            for(auto& c : components) c->update();
-        }
+        Entity(Manager& mManager, std::size_t mIndex) : manager(mManager), index(mIndex) {}
+        void update();
         void draw() {
             for(auto& c : components) c->draw();
         }
         bool isActive() const { return active; }
-        void destroy() { active = false; }
+        std::size_t getIndex() const { return index; }
+        EntityHandle getHandle() const { return { static_cast<std::uint32_t>(index), generation }; }
+        Manager& getManager() const { return manager; }
+        void destroy();
 
         bool hasGroup(Group mGroup) {
             return groupBitSet[mGroup];
         }
 
         void addGroup(Group mGroup);
-        void delGroup(Group mGroup) {
-            groupBitSet[mGroup] = false;
-        }
+        void delGroup(Group mGroup);
 
         template <typename T> bool hasComponent() const {
-            return componentBitSet[getComponentTypeID<T>()];
+            return componentBitSet[componentTypeID<T>];
+        }
+
+        template <typename... Ts> bool hasComponents() const {
+            return (componentBitSet & componentMask<Ts...>) == componentMask<Ts...>;
         }
 
         template <typename T, typename... TArgs>
-        T& addComponent(TArgs&&... mArgs) {
-            T* c(new T(std::forward<TArgs>(mArgs)...));
-            c->entity = this;
-            std::unique_ptr<Component> uPtr{ c };
-            components.emplace_back(std::move(uPtr));
+        T& addComponent(TArgs&&... mArgs);
 
-            componentArray[getComponentTypeID<T>()] = c;
-            componentBitSet[getComponentTypeID<T>()] = true;
-
-            c->init();
-            return *c;
-        }
+        void releaseComponents();
 
         template <typename T> T& getComponent() const {
-            auto ptr(componentArray[getComponentTypeID<T>()]);
+            auto ptr(componentArray[componentTypeID<T>]);
             return *static_cast<T*>(ptr);
         }
         
@@ -105,21 +276,138 @@ class Entity {
 
 class Manager {
     private:
-        std::vector<std::unique_ptr<Entity>> entities;
+        std::array<std::unique_ptr<ComponentPoolBase>, maxComponents> pools;
+        std::vector<std::unique_ptr<Entity>> slots;
+        std::vector<std::size_t> freeIndices;
+        std::vector<Entity*> entities;
+        std::vector<Entity*> pendingRefresh;
+        std::vector<Entity*> pendingAdds;
+        std::vector<std::pair<Entity*, Group>> pendingGroupAdds;
+        int deferDepth = 0;
         std::array<std::vector<Entity*>, maxGroups> groupedEntities;
+        std::array<std::vector<std::size_t>, maxGroups> groupPositions;
         std::vector<std::unique_ptr<System>> systems;
+        std::vector<std::vector<std::size_t>> systemDependents;
+        std::vector<int> systemDependencyCount;
+        ComponentBitSet scheduledComponents;
+        JobSystem* jobs = nullptr;
+
+        // Per-frame scheduling state lives on the manager so a worker finishing the last
+        // system never touches anything that has gone out of scope in runSystems.
+        std::unique_ptr<std::atomic<int>[]> systemsRemaining;
+        std::atomic<std::size_t> systemsFinished{0};
+        std::mutex systemsMutex;
+        std::condition_variable systemsDone;
+
+        void runSystem(std::size_t i) {
+            systems[i]->update();
+            for (std::size_t dependent : systemDependents[i]) {
+                if (--systemsRemaining[dependent] == 0) {
+                    jobs->Submit([this, dependent]() { runSystem(dependent); });
+                }
+            }
+            if (++systemsFinished == systems.size()) {
+                std::lock_guard<std::mutex> lock(systemsMutex);
+                systemsDone.notify_one();
+            }
+        }
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
     public:
         void update() {
-            for(auto& s : systems) s->update();
+            beginDeferred();
+            runSystems();
             for(auto& e : entities) e->update();
+            endDeferred();
+        }
+
+        void setJobSystem(JobSystem* jobSystem) {
+            jobs = jobSystem;
+        }
+
+        bool isScheduled(ComponentID id) const {
+            return scheduledComponents[id];
         }
 
+        void runSystems() {
+            if (systems.empty()) {
+                return;
+            }
+
+            if (jobs == nullptr) {
+                for (auto& s : systems) s->update();
+            } else {
+                std::size_t count = systems.size();
+                systemsFinished = 0;
+                for (std::size_t i = 0; i < count; i++) {
+                    systemsRemaining[i] = systemDependencyCount[i];
+                }
+                for (std::size_t i = 0; i < count; i++) {
+                    if (systemDependencyCount[i] == 0) {
+                        jobs->Submit([this, i]() { runSystem(i); });
+                    }
+                }
+
+                // The calling thread helps drain the queues instead of just blocking.
+                while (systemsFinished < count) {
+                    if (!jobs->RunPending()) {
+                        std::unique_lock<std::mutex> lock(systemsMutex);
+                        systemsDone.wait_for(lock, std::chrono::microseconds(100), [&]() { return systemsFinished == count; });
+                    }
+                }
+            }
+
+            for (auto& s : systems) s->sync();
+        }
+
+        // While deferred, new entities and group memberships are recorded instead of being
+        // pushed into the vectors a caller may be iterating; endDeferred applies them in one batch.
+        void beginDeferred() {
+            deferDepth++;
+        }
+
+        void endDeferred() {
+            if (--deferDepth > 0) {
+                return;
+            }
+
+            entities.reserve(entities.size() + pendingAdds.size());
+            for (Entity* e : pendingAdds) {
+                e->listPosition = entities.size();
+                entities.push_back(e);
+            }
+            pendingAdds.clear();
+
+            for (auto& add : pendingGroupAdds) {
+                if (add.first->hasGroup(add.second)) {
+                    AddToGroup(add.first, add.second);
+                }
+            }
+            pendingGroupAdds.clear();
+
+            refresh();
+        }
+
+        // Systems are ordered by registration; a system depends on every earlier one it conflicts with.
         template<typename T, typename... TArgs>
         T& addSystem(TArgs&&... args) {
             T* s(new T(std::forward<TArgs>(args)...));
             std::unique_ptr<System> uPtr{ s };
+
+            std::size_t index = systems.size();
+            systemDependents.emplace_back();
+            systemDependencyCount.push_back(0);
+            for (std::size_t i = 0; i < index; i++) {
+                if (systems[i]->conflictsWith(*s)) {
+                    systemDependents[i].push_back(index);
+                    systemDependencyCount[index]++;
+                }
+            }
+
+            scheduledComponents |= s->driven;
             systems.emplace_back(std::move(uPtr));
+            systemsRemaining.reset(new std::atomic<int>[systems.size()]);
             return *s;
         }
 
@@ -128,32 +416,56 @@ class Manager {
         }
 
         void refresh() {
-            for(auto i(0u); i < maxGroups; i++) {
-                auto& v(groupedEntities[i]);
-                v.erase(
-                    std::remove_if(std::begin(v), std::end(v), 
-                    [i](Entity* mEntity) {
-                        return !mEntity->isActive() || !mEntity->hasGroup(i);
-                    }),
-                    std::end(v));
+            if (deferDepth > 0) {
+                return;
+            }
+
+            for (std::size_t p = 0; p < pendingRefresh.size(); p++) {
+                Entity* mEntity = pendingRefresh[p];
+                mEntity->pendingRefresh = false;
+
+                for (Group g = 0; g < maxGroups; g++) {
+                    if (inGroup(mEntity, g) && (!mEntity->isActive() || !mEntity->hasGroup(g))) {
+                        RemoveFromGroup(mEntity, g);
+                    }
+                }
+
+                if (mEntity->isActive()) {
+                    continue;
+                }
+
+                Entity* last = entities.back();
+                entities[mEntity->listPosition] = last;
+                last->listPosition = mEntity->listPosition;
+                entities.pop_back();
+
+                // The slot and its Entity object are kept for reuse; bumping the generation invalidates old handles.
+                mEntity->releaseComponents();
+                mEntity->groupBitSet.reset();
+                mEntity->generation++;
+                freeIndices.push_back(mEntity->getIndex());
             }
+            pendingRefresh.clear();
+        }
 
-            entities.erase(std::remove_if(std::begin(entities), std::end(entities),
-            [](const std::unique_ptr<Entity> &mEntity) {
-                return !mEntity->isActive();
-            }), 
-            std::end(entities));
+        void queueRefresh(Entity* mEntity) {
+            if (!mEntity->pendingRefresh) {
+                mEntity->pendingRefresh = true;
+                pendingRefresh.push_back(mEntity);
+            }
         }
 
         void clear() {
-            for (auto& e : entities) {
+            for (std::size_t i = 0; i < entities.size(); i++) {
+                Entity* e = entities[i];
                 e->destroy();
             }
             refresh();
         }
         
         void clearAllExcept(Group groupToKeep) {
-            for (auto& e : entities) {
+            for (std::size_t i = 0; i < entities.size(); i++) {
+                Entity* e = entities[i];
                 if (!e->hasGroup(groupToKeep)) {
                     e->destroy();
                 }
@@ -162,9 +474,40 @@ class Manager {
         }
 
         void AddToGroup(Entity* mEntity, Group mGroup) {
+            if (inGroup(mEntity, mGroup)) {
+                return;
+            }
+
+            if (deferDepth > 0) {
+                pendingGroupAdds.emplace_back(mEntity, mGroup);
+                return;
+            }
+
+            auto& positions = groupPositions[mGroup];
+            if (positions.size() <= mEntity->getIndex()) {
+                positions.resize(mEntity->getIndex() + 1, npos);
+            }
+            positions[mEntity->getIndex()] = groupedEntities[mGroup].size();
             groupedEntities[mGroup].emplace_back(mEntity);
         }
 
+        void RemoveFromGroup(Entity* mEntity, Group mGroup) {
+            auto& group = groupedEntities[mGroup];
+            auto& positions = groupPositions[mGroup];
+            std::size_t position = positions[mEntity->getIndex()];
+
+            Entity* last = group.back();
+            group[position] = last;
+            positions[last->getIndex()] = position;
+            group.pop_back();
+            positions[mEntity->getIndex()] = npos;
+        }
+
+        bool inGroup(Entity* mEntity, Group mGroup) const {
+            const auto& positions = groupPositions[mGroup];
+            return mEntity->getIndex() < positions.size() && positions[mEntity->getIndex()] != npos;
+        }
+
         std::vector<Entity*>& getGroup(Group mGroup) {
             return groupedEntities[mGroup];
         }
@@ -178,9 +521,128 @@ class Manager {
         }
 
         Entity& addEntity() {
-            Entity* e = new Entity(*this);
-            std::unique_ptr<Entity> uPtr{ e };
-            entities.emplace_back(std::move(uPtr));
+            Entity* e;
+            if (!freeIndices.empty()) {
+                e = slots[freeIndices.back()].get();
+                freeIndices.pop_back();
+                e->active = true;
+            } else {
+                e = new Entity(*this, slots.size());
+                slots.emplace_back(e);
+            }
+
+            if (deferDepth > 0) {
+                pendingAdds.push_back(e);
+            } else {
+                e->listPosition = entities.size();
+                entities.push_back(e);
+            }
             return *e;
         }
-};
\ No newline at end of file
+
+        Entity* get(EntityHandle handle) const {
+            if (handle.index >= slots.size()) {
+                return nullptr;
+            }
+            Entity* e = slots[handle.index].get();
+            return e->generation == handle.generation ? e : nullptr;
+        }
+
+        bool isValid(EntityHandle handle) const {
+            return get(handle) != nullptr;
+        }
+
+        template <typename T>
+        ComponentPool<T>& getPool() {
+            auto& pool = pools[componentTypeID<T>];
+            if (!pool) {
+                pool.reset(new ComponentPool<T>());
+            }
+            return *static_cast<ComponentPool<T>*>(pool.get());
+        }
+
+        void destroyComponent(ComponentID id, std::size_t index) {
+            if (pools[id]) {
+                pools[id]->destroy(index);
+            }
+        }
+
+        template <typename... Ts>
+        class View {
+            public:
+                View(Manager& mManager) : manager(mManager) {}
+
+                template <typename F>
+                void each(F&& f) {
+                    // Walk the smallest pool; the rest are checked through the entity's component bitset.
+                    const std::vector<std::size_t>* smallest = nullptr;
+                    for (const std::vector<std::size_t>* candidate : { &manager.getPool<Ts>().indices()... }) {
+                        if (smallest == nullptr || candidate->size() < smallest->size()) {
+                            smallest = candidate;
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < smallest->size(); i++) {
+                        Entity* e = manager.slots[(*smallest)[i]].get();
+                        if (e->isActive() && e->template hasComponents<Ts...>()) {
+                            f(*e, *manager.getPool<Ts>().get(e->getIndex())...);
+                        }
+                    }
+                }
+
+            private:
+                Manager& manager;
+        };
+
+        template <typename... Ts>
+        View<Ts...> view() {
+            return View<Ts...>(*this);
+        }
+};
+
+inline void Entity::update() {
+    for(auto& c : components) {
+        if (!manager.isScheduled(c->typeID)) {
+            c->update();
+        }
+    }
+}
+
+template <typename T, typename... TArgs>
+T& Entity::addComponent(TArgs&&... mArgs) {
+    T* c = manager.getPool<T>().emplace(index, std::forward<TArgs>(mArgs)...);
+    c->entity = this;
+    c->typeID = componentTypeID<T>;
+    components.emplace_back(c);
+
+    componentArray[componentTypeID<T>] = c;
+    componentBitSet[componentTypeID<T>] = true;
+
+    c->init();
+    return *c;
+}
+
+// Long-lived reference to an entity. Dereferences to nullptr once the entity has been
+// destroyed and its slot recycled, instead of aliasing whatever entity reuses the slot.
+class EntityRef {
+    public:
+        EntityRef() {}
+        EntityRef(std::nullptr_t) {}
+        EntityRef(Entity* e) {
+            if (e != nullptr) {
+                manager = &e->getManager();
+                handle = e->getHandle();
+            }
+        }
+
+        Entity* get() const { return manager != nullptr ? manager->get(handle) : nullptr; }
+        EntityHandle getHandle() const { return handle; }
+
+        operator Entity*() const { return get(); }
+        Entity* operator->() const { return get(); }
+        Entity& operator*() const { return *get(); }
+
+    private:
+        Manager* manager = nullptr;
+        EntityHandle handle;
+};
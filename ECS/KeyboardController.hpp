@@ -142,7 +142,7 @@ class KeyboardController : public Component {
             int deltaX = mouseX - playerCenterX;
             int deltaY = mouseY - playerCenterY;
             
-            float angle = atan2(deltaY, deltaX) * 180.0f / M_PI;
+            float angle = atan2(deltaY, deltaX) * 180.0f / 3.14159265f;
             
             if (angle < 0) angle += 360.0f;
             
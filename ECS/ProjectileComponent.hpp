@@ -15,20 +15,21 @@ class ProjectileComponent : public Component {
         }
 
         void update() override {
-            distance += speed;
-
-            if(distance > range) {
-                entity->destroy();
-            }
-            else if(transform->position.x > Game::camera.x + Game::camera.w ||
-                    transform->position.x < Game::camera.x ||
-                    transform->position.y > Game::camera.y + Game::camera.h ||
-                    transform->position.y < Game::camera.y
-            ) {
+            if (advance()) {
                 entity->destroy();
             }
         }
 
+        bool advance() {
+            distance += speed;
+
+            return distance > range ||
+                   transform->position.x > Game::camera.x + Game::camera.w ||
+                   transform->position.x < Game::camera.x ||
+                   transform->position.y > Game::camera.y + Game::camera.h ||
+                   transform->position.y < Game::camera.y;
+        }
+
     private:
         TransformComponent* transform;
 
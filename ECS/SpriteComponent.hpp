@@ -12,6 +12,8 @@ class SpriteComponent : public Component {
         TransformComponent *transform;
         SDL_Texture *texture;
         SDL_Rect srcRect, destRect;
+        // Where the sheet sits in its texture; frames are laid out relative to it.
+        SDL_Rect region = { 0, 0, 0, 0 };
         std::string textureID;
 
         bool animated = false;
@@ -87,7 +89,7 @@ class SpriteComponent : public Component {
         }
         void setTex(std::string id) {
             textureID = id;
-            texture = Game::assets->GetTexture(id);
+            Game::assets->GetTextureRegion(id, texture, region);
         }
 
         std::string getTexID() const {
@@ -102,17 +104,18 @@ class SpriteComponent : public Component {
 
             transform = &entity->getComponent<TransformComponent>();
 
-            srcRect.x = srcRect.y = 0;
+            srcRect.x = region.x;
+            srcRect.y = region.y;
             srcRect.w = transform->width;
             srcRect.h = transform->height;
         }
 
         void update() override {
             if(animated) {
-                srcRect.x = srcRect.w * static_cast<int>((SDL_GetTicks() / speed) % frames);
+                srcRect.x = region.x + srcRect.w * static_cast<int>((SDL_GetTicks() / speed) % frames);
             }
 
-            srcRect.y = animIndex * transform->height;
+            srcRect.y = region.y + animIndex * transform->height;
 
             destRect.x = static_cast<int>(transform->position.x) - Game::camera.x;
             destRect.y = static_cast<int>(transform->position.y) - Game::camera.y;
@@ -142,7 +145,13 @@ class SpriteComponent : public Component {
         }
 
         void draw() override {
-            if (isClue) {
+            Vector2D drawPosition = transform->InterpolatedPosition(Game::renderAlpha);
+            destRect.x = static_cast<int>(drawPosition.x) - Game::camera.x;
+            destRect.y = static_cast<int>(drawPosition.y) - Game::camera.y;
+
+            if (Game::spriteBatch.IsRecording()) {
+                Game::spriteBatch.Add(texture, srcRect, destRect, spriteFlip, isClue ? alpha : 255);
+            } else if (isClue) {
                 TextureManager::Draw(texture, srcRect, destRect, spriteFlip, alpha);
             } else {
                 TextureManager::Draw(texture, srcRect, destRect, spriteFlip);
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ECS.hpp"
+#include "Components.hpp"
+
+class MovementSystem : public System {
+    public:
+        MovementSystem(Manager& mManager) : manager(mManager) {
+            drive<TransformComponent>();
+        }
+
+        void update() override {
+            manager.view<TransformComponent>().each([](Entity&, TransformComponent& transform) {
+                transform.update();
+            });
+        }
+
+    private:
+        Manager& manager;
+};
+
+class EnemyAISystem : public System {
+    public:
+        EnemyAISystem(Manager& mManager) : manager(mManager) {
+            drive<EnemyAIComponent>();
+            write<TransformComponent>();
+            write<SpriteComponent>();
+        }
+
+        void update() override {
+            manager.view<EnemyAIComponent>().each([](Entity&, EnemyAIComponent& ai) {
+                ai.update();
+            });
+        }
+
+    private:
+        Manager& manager;
+};
+
+class SpriteAnimationSystem : public System {
+    public:
+        SpriteAnimationSystem(Manager& mManager) : manager(mManager) {
+            drive<SpriteComponent>();
+            read<TransformComponent>();
+        }
+
+        void update() override {
+            manager.view<SpriteComponent>().each([](Entity&, SpriteComponent& sprite) {
+                sprite.update();
+            });
+        }
+
+    private:
+        Manager& manager;
+};
+
+class ProjectileSystem : public System {
+    public:
+        ProjectileSystem(Manager& mManager) : manager(mManager) {
+            drive<ProjectileComponent>();
+            read<TransformComponent>();
+        }
+
+        void update() override {
+            manager.view<ProjectileComponent>().each([this](Entity& e, ProjectileComponent& projectile) {
+                if (projectile.advance()) {
+                    expired.push_back(&e);
+                }
+            });
+        }
+
+        void sync() override {
+            for (auto e : expired) {
+                e->destroy();
+            }
+            expired.clear();
+        }
+
+    private:
+        Manager& manager;
+        std::vector<Entity*> expired;
+};
@@ -7,6 +7,7 @@ class TransformComponent : public Component {
     public:
 
         Vector2D position;
+        Vector2D previousPosition;
         Vector2D velocity;
 
         int height = 32;
@@ -44,7 +45,19 @@ class TransformComponent : public Component {
         }
         void init() override {
             velocity.Zero();
+            previousPosition = position;
         }
+
+        Vector2D InterpolatedPosition(float alpha) const {
+            float dx = position.x - previousPosition.x;
+            float dy = position.y - previousPosition.y;
+            if (dx * dx + dy * dy > snapDistance * snapDistance) {
+                return position;
+            }
+            return Vector2D(previousPosition.x + dx * alpha, previousPosition.y + dy * alpha);
+        }
+
+        static constexpr float snapDistance = 128.0f;
         void update() override { 
             position.x += velocity.x * speed;
             position.y += velocity.y * speed;
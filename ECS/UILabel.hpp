@@ -6,6 +6,9 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
 #include <functional>
 
 class UILabel : public Component {
@@ -13,7 +16,7 @@ class UILabel : public Component {
         UILabel(int xpos, int ypos, std::string text, std::string font, SDL_Color& color) : labelText(text),  labelFont(font), textColor(color){
             position.x = xpos; 
             position.y = ypos;
-            labelTexture = nullptr;
+            position.w = position.h = 0;
             clickable = false;
             onClick = nullptr;
             hoverColor = {255, 255, 0, 255};
@@ -22,57 +25,37 @@ class UILabel : public Component {
             SetLabelText(labelText, labelFont);
         }
         
-        ~UILabel() {
-            if (labelTexture != nullptr) {
-                SDL_DestroyTexture(labelTexture);
-                labelTexture = nullptr;
-            }
-        }
-        
         void init() override {
             entity->addGroup(Game::groupUI);
         }
 
         void SetLabelText(std::string text, std::string font) {
-            if (labelTexture != nullptr) {
-                SDL_DestroyTexture(labelTexture);
-                labelTexture = nullptr;
-            }
-            
+            boundValues.clear();
             labelText = text;
             labelFont = font;
-            
-            if (text.empty()) {
-                return;
-            }
-            
-            SDL_Surface* surf = TTF_RenderText_Blended(Game::assets->GetFont(font), text.c_str(), textColor);
-            labelTexture = SDL_CreateTextureFromSurface(Game::renderer, surf);
-            SDL_FreeSurface(surf);
-
-            SDL_QueryTexture(labelTexture, nullptr, nullptr, &position.w, &position.h);
+            RebuildQuads();
         }
         
         void SetLabelText(std::string text, std::string font, SDL_Color color) {
-            if (labelTexture != nullptr) {
-                SDL_DestroyTexture(labelTexture);
-                labelTexture = nullptr;
-            }
-            
+            boundValues.clear();
             textColor = color;
             originalColor = color;
             labelText = text;
             labelFont = font;
-            
-            if (text.empty()) {
-                return;
+            RebuildQuads();
+        }
+        
+        template<typename Formatter>
+        bool SetBoundText(std::initializer_list<int> values, Formatter format) {
+            if (boundValues.size() == values.size() && std::equal(values.begin(), values.end(), boundValues.begin())) {
+                skippedRebuilds++;
+                return false;
             }
-            
-            SDL_Surface* surf = TTF_RenderText_Blended(Game::assets->GetFont(font), text.c_str(), textColor);
-            labelTexture = SDL_CreateTextureFromSurface(Game::renderer, surf);
-            SDL_FreeSurface(surf);
 
-            SDL_QueryTexture(labelTexture, nullptr, nullptr, &position.w, &position.h);
+            SetLabelText(format(), labelFont);
+            boundValues.assign(values.begin(), values.end());
+            boundRebuilds++;
+            return true;
         }
         
         void SetTextColor(SDL_Color color) {
@@ -82,21 +65,9 @@ class UILabel : public Component {
             }
             
             textColor = color;
-            
-            if (labelText.empty()) {
-                return;
+            for (auto& vertex : vertices) {
+                vertex.color = color;
             }
-            
-            if (labelTexture != nullptr) {
-                SDL_DestroyTexture(labelTexture);
-                labelTexture = nullptr;
-            }
-            
-            SDL_Surface* surf = TTF_RenderText_Blended(Game::assets->GetFont(labelFont), labelText.c_str(), textColor);
-            labelTexture = SDL_CreateTextureFromSurface(Game::renderer, surf);
-            SDL_FreeSurface(surf);
-
-            SDL_QueryTexture(labelTexture, nullptr, nullptr, &position.w, &position.h);
         }
         
         void SetClickable(bool clickable) {
@@ -155,8 +126,8 @@ class UILabel : public Component {
         }
 
         void draw() override{
-            if (labelTexture != nullptr) {
-                SDL_RenderCopy(Game::renderer, this->labelTexture, nullptr, &this->position);
+            if (atlas != nullptr) {
+                atlas->Draw(vertices, position.x, position.y);
             }
         }
         
@@ -177,12 +148,30 @@ class UILabel : public Component {
             return position;
         }
         
+        static inline long long boundRebuilds = 0;
+        static inline long long skippedRebuilds = 0;
+        
     private:
+        void RebuildQuads() {
+            vertices.clear();
+            position.w = position.h = 0;
+            atlas = nullptr;
+
+            if (labelText.empty()) {
+                return;
+            }
+
+            atlas = Game::assets->GetGlyphAtlas(labelFont);
+            atlas->BuildQuads(labelText, textColor, vertices, position.w, position.h);
+        }
+
         SDL_Rect position;
         std::string labelText;
         std::string labelFont;
         SDL_Color textColor;
-        SDL_Texture* labelTexture;
+        GlyphAtlas* atlas = nullptr;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> boundValues;
         
         bool clickable;
         std::function<void()> onClick;
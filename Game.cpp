@@ -2,6 +2,7 @@
 #include "TextureManager.hpp"
 #include "Map.hpp"
 #include "ECS/Components.hpp"
+#include "ECS/Systems.hpp"
 #include "Vector2D.hpp"
 #include "Collision.hpp"
 #include "AssetManager.hpp"
@@ -18,19 +19,17 @@
 Map* map;
 Manager manager;
 
-Entity* player = nullptr;
-Entity* finalBoss = nullptr;
-Entity* healthbar = nullptr;
-Entity* ammobar = nullptr;
-Entity* gameover = nullptr;
-Entity* clueCounter = nullptr;
-Entity* feedbackLabel = nullptr;
-Entity* scientist = nullptr;
+EntityRef player = nullptr;
+EntityRef finalBoss = nullptr;
+EntityRef healthbar = nullptr;
+EntityRef ammobar = nullptr;
+EntityRef gameover = nullptr;
+EntityRef clueCounter = nullptr;
+EntityRef feedbackLabel = nullptr;
+EntityRef scientist = nullptr;
 
-std::vector<Entity*>* tiles;
 std::vector<Entity*>* players;
 std::vector<Entity*>* enemies;
-std::vector<Entity*>* colliders;
 std::vector<Entity*>* projectiles;
 std::vector<Entity*>* objects;
 std::vector<Entity*>* ui;
@@ -45,6 +44,9 @@ bool objectCollisionsEnabled = false;
 SDL_Renderer *Game::renderer = nullptr;
 SDL_Event Game::event;
 SDL_Rect Game::camera = {0, 0, 1920, 1080};
+float Game::renderAlpha = 1.0f;
+Game::RenderStats Game::renderStats;
+SpriteBatch Game::spriteBatch;
 bool Game::isRunning = false;
 AssetManager* Game::assets = nullptr;
 int Game::totalClues = 3;
@@ -52,12 +54,13 @@ int Game::totalMagazines = 3;
 int Game::totalHealthPotions = 2;
 int Game::collectedClues = 0;
 bool Game::gameOver = false;
+bool Game::debugColliders = false;
 bool Game::playerWon = false;
 bool Game::questionActive = false;
-Entity* Game::pendingClueEntity = nullptr;
+EntityRef Game::pendingClueEntity = nullptr;
 bool Game::showFeedback = false;
 Uint32 Game::feedbackStartTime = 0;
-Entity* Game::feedbackLabel = nullptr;
+EntityRef Game::feedbackLabel = nullptr;
 int Game::currentLevel = 1;
 int Game::maxLevels = 4;
 bool Game::showingExitInstructions = false;
@@ -70,7 +73,7 @@ bool Game::canRescueScientist = false;
 bool Game::returnToMainMenu = false;
 Uint32 Game::gameStartTime = 0;
 Uint32 Game::gameplayTime = 0;
-Entity* Game::timerLabel = nullptr;
+EntityRef Game::timerLabel = nullptr;
 int Game::volumeLevel = 75;
 
 std::string Game::currentMusic = "";
@@ -82,41 +85,41 @@ Vector2D Game::lastRecordedPosition = Vector2D(0, 0);
 Uint32 Game::replayFrameTime = 20;
 Uint32 Game::lastReplayFrameTime = 0;
 
-Entity* menuTitle = nullptr;
-Entity* menuNewGameButton = nullptr;
-Entity* menuLoadGameButton = nullptr;
-Entity* menuSettingsButton = nullptr;
-Entity* menuLeaderboardButton = nullptr;
-Entity* menuExitButton = nullptr;
+EntityRef menuTitle = nullptr;
+EntityRef menuNewGameButton = nullptr;
+EntityRef menuLoadGameButton = nullptr;
+EntityRef menuSettingsButton = nullptr;
+EntityRef menuLeaderboardButton = nullptr;
+EntityRef menuExitButton = nullptr;
 int selectedMenuItem = MENU_NEW_GAME;
 bool menuHighlightActive = false;
 bool menuItemSelected = false;
 
-Entity* endTitle = nullptr;
-Entity* endMessage = nullptr;
-Entity* endRestartButton = nullptr;
-Entity* endReplayButton = nullptr;
-Entity* endMenuButton = nullptr;
+EntityRef endTitle = nullptr;
+EntityRef endMessage = nullptr;
+EntityRef endRestartButton = nullptr;
+EntityRef endReplayButton = nullptr;
+EntityRef endMenuButton = nullptr;
 int selectedEndOption = END_RESTART;
 bool endOptionSelected = false;
 bool endHighlightActive = false;
 
-Entity* pauseTitle = nullptr;
-Entity* pauseResumeButton = nullptr;
-Entity* pauseSaveButton = nullptr;
-Entity* pauseRestartButton = nullptr;
-Entity* pauseSettingsButton = nullptr;
-Entity* pauseMainMenuButton = nullptr;
-Entity* pauseBackground = nullptr;
+EntityRef pauseTitle = nullptr;
+EntityRef pauseResumeButton = nullptr;
+EntityRef pauseSaveButton = nullptr;
+EntityRef pauseRestartButton = nullptr;
+EntityRef pauseSettingsButton = nullptr;
+EntityRef pauseMainMenuButton = nullptr;
+EntityRef pauseBackground = nullptr;
 int selectedPauseItem = PAUSE_RESUME;
 bool pauseHighlightActive = false;
 bool pauseItemSelected = false;
 
-Entity* settingsTitle = nullptr;
-Entity* volumeLabel = nullptr;
-Entity* keybindsLabel = nullptr;
-Entity* settingsBackButton = nullptr;
-Entity* settingsBackground = nullptr;
+EntityRef settingsTitle = nullptr;
+EntityRef volumeLabel = nullptr;
+EntityRef keybindsLabel = nullptr;
+EntityRef settingsBackButton = nullptr;
+EntityRef settingsBackground = nullptr;
 int selectedSettingsItem = SETTINGS_VOLUME;
 bool settingsHighlightActive = false;
 bool settingsItemSelected = false;
@@ -125,7 +128,7 @@ bool draggingVolumeSlider = false;
 bool Game::hasSavedDuringExitInstructions = false;
 std::string Game::savedExitInstructionsText = "";
 
-void writeString(std::ofstream& file, const std::string& str) {
+void writeString(std::ostream& file, const std::string& str) {
     size_t len = str.length();
     file.write(reinterpret_cast<const char*>(&len), sizeof(len));
     file.write(str.c_str(), len);
@@ -237,6 +240,7 @@ Game::Game()
 
 Game::~Game()
 {
+    jobs.Shutdown();
     delete assets;
 }
 
@@ -257,10 +261,8 @@ void Game::initEntities() {
     answer4Label = &manager.addEntity();
     questionBackground = &manager.addEntity();
     
-    tiles = &manager.getGroup(Game::groupMap);
     players = &manager.getGroup(Game::groupPlayers);
     enemies = &manager.getGroup(Game::groupEnemies);
-    colliders = &manager.getGroup(Game::groupColliders);
     projectiles = &manager.getGroup(Game::groupProjectiles);
     objects = &manager.getGroup(Game::groupObjects);
     ui = &manager.getGroup(Game::groupUI);
@@ -356,6 +358,7 @@ void Game::initEntities() {
 
 void Game::init(const char* title, int xpos, int ypos, int width, int height, bool fullscreen)
 {
+    Uint64 startupStart = SDL_GetPerformanceCounter();
     int flags = 0;
     if(fullscreen) {
         flags = SDL_WINDOW_FULLSCREEN;
@@ -363,7 +366,10 @@ void Game::init(const char* title, int xpos, int ypos, int width, int height, bo
 
     if (SDL_Init(SDL_INIT_EVERYTHING) == 0) {
         window = SDL_CreateWindow(title, xpos, ypos, width, height, flags);
-        renderer = SDL_CreateRenderer(window, -1, 0);
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        if (!renderer) {
+            renderer = SDL_CreateRenderer(window, -1, 0);
+        }
 
         if(renderer) {
             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
@@ -393,47 +399,67 @@ void Game::init(const char* title, int xpos, int ypos, int width, int height, bo
     }
 
     assets = new AssetManager(&manager);
+    if (!assets->MountArchive("assets.pak")) {
+        std::cout << "No asset archive found, loading loose files from assets/" << std::endl;
+    }
 
-    assets->AddTexture("terrainlvl1", "./assets/lvl1/TerrainTexturesLevel1.png");
-    assets->AddTexture("terrainlvl2", "./assets/lvl2/TerrainTexturesLevel2.png");
-    assets->AddTexture("terrainlvl3", "./assets/lvl3/TerrainTexturesLevel3.png");
-    assets->AddTexture("terrainlvl4", "./assets/lvl4/TerrainTexturesLevel4.png");
-
-    assets->AddTexture("player", "./assets/entities/playeranimations.png");
-    assets->AddTexture("enemy", "./assets/entities/enemyanimations.png");
-    assets->AddTexture("boss", "./assets/entities/finalbossanimations.png");
-    assets->AddTexture("scientist", "./assets/entities/scientistanimations.png");
+    manager.setJobSystem(&jobs);
+    manager.addSystem<MovementSystem>(manager);
+    manager.addSystem<EnemyAISystem>(manager);
+    manager.addSystem<SpriteAnimationSystem>(manager);
+    manager.addSystem<ProjectileSystem>(manager);
 
-    assets->AddTexture("clue", "./assets/objects/clue.png");
-    assets->AddTexture("magazine", "./assets/objects/magazine.png");
-    assets->AddTexture("bulletHorizontal", "./assets/projectiles/bulletHorizontal.png");
-    assets->AddTexture("bulletVertical", "./assets/projectiles/bulletVertical.png");
-    assets->AddTexture("healthpotion", "./assets/objects/healthpotion.png");
-    assets->AddTexture("cactus", "./assets/objects/cactus.png");
-    
     assets->AddFont("font1", "./assets/MINECRAFT.TTF", 32);
     assets->AddFont("font2", "./assets/MINECRAFT.TTF", 72);
 
-    assets->AddSound("click", "./assets/sounds/click.mp3");
-    assets->AddSound("shoot", "./assets/sounds/shoot.wav");
-    assets->AddSound("hurt", "./assets/sounds/hurt.wav");
-    assets->AddSound("levelTransition", "./assets/sounds/leveltransition.wav");
-    assets->AddSound("gameOver", "./assets/sounds/gameover.mp3");
-    assets->AddSound("victory", "./assets/sounds/victory.mp3");
+    assets->DeclareTexture("terrainlvl1", "./assets/lvl1/TerrainTexturesLevel1.png", 1);
+    assets->DeclareTexture("terrainlvl2", "./assets/lvl2/TerrainTexturesLevel2.png", 2);
+    assets->DeclareTexture("terrainlvl3", "./assets/lvl3/TerrainTexturesLevel3.png", 3);
+    assets->DeclareTexture("terrainlvl4", "./assets/lvl4/TerrainTexturesLevel4.png", 4);
+    assets->DeclareTexture("boss", "./assets/entities/finalbossanimations.png", 4);
+    assets->DeclareTexture("scientist", "./assets/entities/scientistanimations.png", 4);
 
-    assets->AddSound("magazine", "./assets/sounds/objects/magazine.wav");
-    assets->AddSound("healthpotion", "./assets/sounds/objects/healthpotion.wav");
+    assets->DeclareMusic("level1", "./assets/sounds/levels/level1.ogg", 1);
+    assets->DeclareMusic("level2", "./assets/sounds/levels/level2.ogg", 2);
+    assets->DeclareMusic("level3-4", "./assets/sounds/levels/level3-4.ogg", 3);
+    assets->DeclareMusic("level3-4", "./assets/sounds/levels/level3-4.ogg", 4);
+    assets->DeclareMusic("boss", "./assets/sounds/levels/bossmusic.ogg", 4);
 
-    assets->AddSound("correctanswer", "./assets/sounds/question/correctanswer.mp3");
-    assets->AddSound("wronganswer", "./assets/sounds/question/wronganswer.mp3");
-    
-    assets->AddMusic("mainmenu", "./assets/sounds/levels/mainmenu.ogg");
-    assets->AddMusic("level1", "./assets/sounds/levels/level1.ogg");
-    assets->AddMusic("level2", "./assets/sounds/levels/level2.ogg");
-    assets->AddMusic("level3-4", "./assets/sounds/levels/level3-4.ogg");
-    assets->AddMusic("boss", "./assets/sounds/levels/bossmusic.ogg");
+    assets->SetMemoryBudget(assetMemoryBudget);
+
+    assets->QueueAtlasTexture("player", "./assets/entities/playeranimations.png");
+    assets->QueueAtlasTexture("enemy", "./assets/entities/enemyanimations.png");
+
+    assets->QueueAtlasTexture("clue", "./assets/objects/clue.png");
+    assets->QueueAtlasTexture("magazine", "./assets/objects/magazine.png");
+    assets->QueueAtlasTexture("bulletHorizontal", "./assets/projectiles/bulletHorizontal.png");
+    assets->QueueAtlasTexture("bulletVertical", "./assets/projectiles/bulletVertical.png");
+    assets->QueueAtlasTexture("healthpotion", "./assets/objects/healthpotion.png");
+    assets->QueueTexture("cactus", "./assets/objects/cactus.png");
+
+    assets->QueueSound("click", "./assets/sounds/click.mp3");
+    assets->QueueSound("shoot", "./assets/sounds/shoot.wav");
+    assets->QueueSound("hurt", "./assets/sounds/hurt.wav");
+    assets->QueueSound("levelTransition", "./assets/sounds/leveltransition.wav");
+    assets->QueueSound("gameOver", "./assets/sounds/gameover.mp3");
+    assets->QueueSound("victory", "./assets/sounds/victory.mp3");
+
+    assets->QueueSound("magazine", "./assets/sounds/objects/magazine.wav");
+    assets->QueueSound("healthpotion", "./assets/sounds/objects/healthpotion.wav");
+
+    assets->QueueSound("correctanswer", "./assets/sounds/question/correctanswer.mp3");
+    assets->QueueSound("wronganswer", "./assets/sounds/question/wronganswer.mp3");
     
+    assets->QueueMusic("mainmenu", "./assets/sounds/levels/mainmenu.ogg");
+
+    Uint64 loadStart = SDL_GetPerformanceCounter();
+    assets->LoadQueued(jobs, [this](int loaded, int total) { renderLoadingProgress(loaded, total); });
+    Uint64 loadEnd = SDL_GetPerformanceCounter();
+    printf("Decoded and uploaded assets in %.1f ms on %d workers\n",
+           (loadEnd - loadStart) * 1000.0 / SDL_GetPerformanceFrequency(), jobs.GetWorkerCount());
+
     assets->SetMasterVolume(volumeLevel);
+    assets->PrintMemoryReport();
 
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
     
@@ -451,6 +477,26 @@ void Game::init(const char* title, int xpos, int ypos, int width, int height, bo
         initEntities();
         loadLevel(currentLevel);
     }
+
+    printf("Startup took %.1f ms\n", (SDL_GetPerformanceCounter() - startupStart) * 1000.0 / SDL_GetPerformanceFrequency());
+}
+
+void Game::renderLoadingProgress(int loaded, int total) {
+    // Keeps the window responsive and shows a plain bar while assets decode; no fonts or textures exist yet.
+    SDL_PumpEvents();
+
+    int barWidth = 800;
+    int barHeight = 32;
+    SDL_Rect outline = { (1920 - barWidth) / 2, (1080 - barHeight) / 2, barWidth, barHeight };
+    SDL_Rect fill = outline;
+    fill.w = total > 0 ? barWidth * loaded / total : barWidth;
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderFillRect(renderer, &fill);
+    SDL_RenderDrawRect(renderer, &outline);
+    SDL_RenderPresent(renderer);
 }
 
 void Game::handleEvents()
@@ -461,6 +507,12 @@ void Game::handleEvents()
         case SDL_QUIT:
             isRunning = false;
             break;
+
+        case SDL_RENDER_TARGETS_RESET:
+            if (map != nullptr) {
+                map->BakeChunks();
+            }
+            break;
             
         case SDL_KEYDOWN:
             if (gameState == STATE_REPLAY && event.key.keysym.sym == SDLK_ESCAPE) {
@@ -545,6 +597,21 @@ void Game::handleEvents()
                 if (event.key.keysym.sym == SDLK_ESCAPE) {
                     togglePause();
                 }
+                else if (event.key.keysym.sym == SDLK_F1) {
+                    debugColliders = !debugColliders;
+                    if (debugColliders && assets->GetTexture("collider") == nullptr) {
+                        assets->AddTexture("collider", "./assets/colliderTex.png");
+                    }
+                }
+                else if (event.key.keysym.sym == SDLK_F2) {
+                    broadphaseBenchmark = !broadphaseBenchmark;
+                    broadphaseStats = BroadphaseStats();
+                }
+                else if (event.key.keysym.sym == SDLK_F3) {
+                    renderStatsReport = !renderStatsReport;
+                    renderTotals = RenderStats();
+                    renderFrames = 0;
+                }
                 else if (event.key.keysym.sym == SDLK_e && currentLevel == 4 && canRescueScientist && !scientistRescued && scientist != nullptr) {
                     Vector2D playerPos = player->getComponent<TransformComponent>().position;
                     Vector2D scientistPos = scientist->getComponent<TransformComponent>().position;
@@ -1031,8 +1098,6 @@ void Game::handleEvents()
 void Game::update()
 {
     Uint32 currentTime = SDL_GetTicks();
-    float deltaTime = (currentTime - lastTime) / 1000.0f;
-    lastTime = currentTime;
     
     if (returnToMainMenu) {
         returnToMainMenu = false;
@@ -1078,6 +1143,7 @@ void Game::update()
         answer3Label = nullptr;
         answer4Label = nullptr;
         questionBackground = nullptr;
+        promptLabel = nullptr;
         
         if (map != nullptr) {
             delete map;
@@ -1119,6 +1185,7 @@ void Game::update()
             
         case STATE_GAME:
             manager.refresh();
+            snapshotTransforms();
             
             if (player && player->isActive() && !isReplaying) {
                 recordPlayerPosition();
@@ -1131,13 +1198,13 @@ void Game::update()
                 Uint32 minutes = totalSeconds / 60;
                 Uint32 seconds = totalSeconds % 60;
                 
-                std::stringstream timeSS;
-                timeSS << "Time: " << std::setfill('0') << std::setw(2) << minutes 
-                       << ":" << std::setfill('0') << std::setw(2) << seconds;
-                
-                if (timerLabel != nullptr && timerLabel->hasComponent<UILabel>()) {
-                    timerLabel->getComponent<UILabel>().SetLabelText(timeSS.str(), "font1");
-                    
+                if (timerLabel != nullptr && timerLabel->hasComponent<UILabel>() &&
+                    timerLabel->getComponent<UILabel>().SetBoundText({ static_cast<int>(minutes), static_cast<int>(seconds) }, [&]() {
+                        std::stringstream timeSS;
+                        timeSS << "Time: " << std::setfill('0') << std::setw(2) << minutes 
+                               << ":" << std::setfill('0') << std::setw(2) << seconds;
+                        return timeSS.str();
+                    })) {
                     int timerWidth = timerLabel->getComponent<UILabel>().GetWidth();
                     int xPos = (1920 - timerWidth) / 2;
                     timerLabel->getComponent<UILabel>().SetPosition(xPos, 20);
@@ -1181,12 +1248,6 @@ void Game::update()
                 return;
             }
     
-            for(auto& p : *players) {
-                if (p->hasComponent<SpriteComponent>()) {
-                    p->getComponent<SpriteComponent>().update();
-                }
-            }
-            
             for(auto& e : *enemies) {
                 if (!e || !e->isActive()) {
                     continue; 
@@ -1226,32 +1287,26 @@ void Game::update()
                 }
             }
             
-            for(auto& p : *projectiles) {
-                if (p->hasComponent<SpriteComponent>()) {
-                    p->getComponent<SpriteComponent>().update();
+            manager.view<SpriteComponent>().each([](Entity& e, SpriteComponent& sprite) {
+                if (e.hasGroup(groupPlayers) || e.hasGroup(groupProjectiles) || e.hasGroup(groupObjects)) {
+                    sprite.update();
                 }
-            }
-            
-            for(auto& o : *objects) {
-                if(o->hasComponent<SpriteComponent>()) {
-                    o->getComponent<SpriteComponent>().update();
-                }
-            }
+            });
             
             if (player != nullptr && player->isActive() && !gameOver) {
                 int health = player->getComponent<HealthComponent>().health;
-                std::stringstream healthSS;
-                healthSS << "Health: " << health;
-                healthbar->getComponent<UILabel>().SetLabelText(healthSS.str(), "font1");
+                healthbar->getComponent<UILabel>().SetBoundText({ health }, [&]() {
+                    return "Health: " + std::to_string(health);
+                });
                 
                 int ammo = player->getComponent<AmmoComponent>().currentAmmo;
-                std::stringstream ammoSS;
-                ammoSS << "Ammo: " << ammo;
-                ammobar->getComponent<UILabel>().SetLabelText(ammoSS.str(), "font1");
+                ammobar->getComponent<UILabel>().SetBoundText({ ammo }, [&]() {
+                    return "Ammo: " + std::to_string(ammo);
+                });
 
-                std::stringstream clueSS;
-                clueSS << "Clues: " << collectedClues << "/" << totalClues;
-                clueCounter->getComponent<UILabel>().SetLabelText(clueSS.str(), "font1");
+                clueCounter->getComponent<UILabel>().SetBoundText({ collectedClues, totalClues }, [&]() {
+                    return "Clues: " + std::to_string(collectedClues) + "/" + std::to_string(totalClues);
+                });
             }
 
             if (showFeedback) {
@@ -1298,42 +1353,45 @@ void Game::update()
                 player->getComponent<ColliderComponent>().update();
                 SDL_Rect playerCol = player->getComponent<ColliderComponent>().collider;
                 
-                damageTimer -= 1.0f/60.0f;
+                damageTimer -= fixedTimestep;
                 
                 if (hurtSoundTimer > 0.0f) {
-                    hurtSoundTimer -= 1.0f/60.0f;
+                    hurtSoundTimer -= fixedTimestep;
                 }
                 
                 if (!objectCollisionsEnabled) {
-                    objectCollisionDelay -= 1.0f/60.0f;
+                    objectCollisionDelay -= fixedTimestep;
                     if (objectCollisionDelay <= 0.0f) {
                         objectCollisionsEnabled = true;
                     }
                 }
 
                 if (objectCollisionsEnabled) {
+                    objectGrid.clear();
                     for (auto& o : *objects) {
-                        if (Collision::AABB(player->getComponent<ColliderComponent>().collider,
-                                        o->getComponent<ColliderComponent>().collider)) {
-                            if (o->getComponent<ColliderComponent>().tag == "clue") {
-                                showQuestion(o);
-                            }
-                            else if (o->getComponent<ColliderComponent>().tag == "magazine") {
-                                player->getComponent<AmmoComponent>().addAmmo();
-                                o->destroy();
-                                assets->PlaySound("magazine", volumeLevel);
-                            }
-                            else if (o->getComponent<ColliderComponent>().tag == "healthpotion") {
-                                player->getComponent<HealthComponent>().heal(20);
-                                o->destroy();
-                                assets->PlaySound("healthpotion", volumeLevel);
-                            }
+                        objectGrid.insert(o, o->getComponent<ColliderComponent>().collider);
+                    }
+
+                    objectGrid.query(player->getComponent<ColliderComponent>().collider, nearbyEntities);
+                    for (auto& o : nearbyEntities) {
+                        if (o->getComponent<ColliderComponent>().tag == "clue") {
+                            showQuestion(o);
+                        }
+                        else if (o->getComponent<ColliderComponent>().tag == "magazine") {
+                            player->getComponent<AmmoComponent>().addAmmo();
+                            o->destroy();
+                            assets->PlaySound("magazine", volumeLevel);
+                        }
+                        else if (o->getComponent<ColliderComponent>().tag == "healthpotion") {
+                            player->getComponent<HealthComponent>().heal(20);
+                            o->destroy();
+                            assets->PlaySound("healthpotion", volumeLevel);
                         }
                     }
                 }
 
-                for(auto& c : *colliders) {
-                    SDL_Rect cCol = c->getComponent<ColliderComponent>().collider;
+                queryTerrain(player->getComponent<ColliderComponent>().collider, nearbyTiles);
+                for(auto& cCol : nearbyTiles) {
                     SDL_Rect updatedPlayerCol = player->getComponent<ColliderComponent>().collider;
                     
                     if(Collision::AABB(cCol, updatedPlayerCol)) {
@@ -1367,11 +1425,17 @@ void Game::update()
                     }
                 }
 
+                projectileGrid.clear();
+                for (auto& p : *projectiles) {
+                    projectileGrid.insert(p, p->getComponent<ColliderComponent>().collider);
+                }
+
+                manager.beginDeferred();
                 for(auto& e : *enemies) {
                     TransformComponent& enemyTransform = e->getComponent<TransformComponent>();
 
-                    for (auto& c : *colliders) {
-                        SDL_Rect cCol = c->getComponent<ColliderComponent>().collider;
+                    queryTerrain(e->getComponent<ColliderComponent>().collider, nearbyTiles);
+                    for (auto& cCol : nearbyTiles) {
                         SDL_Rect enemyCol = e->getComponent<ColliderComponent>().collider;
 
                         if (Collision::AABB(cCol, enemyCol)) {
@@ -1407,7 +1471,8 @@ void Game::update()
                         }
                     }
 
-                    for(auto& p : *projectiles) {
+                    projectileGrid.query(e->getComponent<ColliderComponent>().collider, nearbyEntities);
+                    for(auto& p : nearbyEntities) {
                         if(Collision::AABB(e->getComponent<ColliderComponent>().collider, 
                                         p->getComponent<ColliderComponent>().collider)) {
                             e->getComponent<HealthComponent>().takeDamage(25);
@@ -1451,27 +1516,18 @@ void Game::update()
                             canRescueScientist = true;   
                             level4MapChanged = true;
                             
-                            for (auto c : *colliders) {
-                                c->destroy();
-                            }
-                            
-                            if (map != nullptr) {
+                            // Only the cells that open the path change, so patch them in place rather than reloading the level.
+                            if (map == nullptr || !map->ApplyPatch("./assets/lvl4/Level4MapAfter.mapd")) {
                                 delete map;
-                                map = nullptr;
+                                map = new Map("terrainlvl4", 2, 32, manager);
+                                map->LoadMap(levelMapPath(4), 60, 34);
                             }
-                            
-                            std::string terrainTexture = "terrainlvl4";
-                            std::string mapPath = "./assets/lvl4/Level4MapAfter.map";
-                            
-                            map = new Map(terrainTexture, 2, 32, manager);
-                            map->LoadMap(mapPath, 60, 34);
-                            
-                            manager.refresh();
                         }
                         
                         e->destroy();
                     }
                 }
+                manager.endDeferred();
 
                 if(player->getComponent<HealthComponent>().health <= 0) {
                     player->destroy();
@@ -1489,6 +1545,10 @@ void Game::update()
                     return;
                 }
 
+                if (broadphaseBenchmark) {
+                    benchmarkBroadphase();
+                }
+
                 camera.x = player->getComponent<TransformComponent>().position.x - (camera.w / 2);
                 camera.y = player->getComponent<TransformComponent>().position.y - (camera.h / 2);
 
@@ -1587,6 +1647,34 @@ void Game::update()
 }
 
 void Game::render() {
+    SDL_Rect simulatedCamera = camera;
+
+    if (gameState != STATE_GAME) {
+        renderAlpha = 1.0f;
+    } else if (previousCamera.w > 0) {
+        int dx = camera.x - previousCamera.x;
+        int dy = camera.y - previousCamera.y;
+        if (dx * dx + dy * dy <= TransformComponent::snapDistance * TransformComponent::snapDistance) {
+            camera.x = previousCamera.x + static_cast<int>(dx * renderAlpha);
+            camera.y = previousCamera.y + static_cast<int>(dy * renderAlpha);
+        }
+    }
+
+    renderFrame();
+    camera = simulatedCamera;
+}
+
+void Game::snapshotTransforms() {
+    previousCamera = camera;
+
+    manager.view<TransformComponent>().each([](Entity&, TransformComponent& transform) {
+        transform.previousPosition = transform.position;
+    });
+}
+
+void Game::renderFrame() {
+    renderStats = RenderStats();
+
     switch (gameState) {
         case STATE_MAIN_MENU:
             renderMainMenu();
@@ -1621,27 +1709,23 @@ void Game::render() {
                 return;
             }
             
-            for (auto& m : manager.getGroup(groupMap)) {
-                m->draw();
+            if (map != nullptr) {
+                map->DrawMap();
             }
             
-            for (auto& c : manager.getGroup(groupColliders)) {
-                c->draw();
-            }
-            for (auto& o : manager.getGroup(groupObjects)) {
-                o->draw();
+            if (debugColliders && map != nullptr) {
+                map->DrawColliders();
             }
-            for (auto& n : manager.getGroup(groupNPCs)) {
-                n->draw();
-            }
-            for (auto& p : manager.getGroup(groupPlayers)) {
-                p->draw();
-            }
-            for (auto& p : manager.getGroup(groupProjectiles)) {
-                p->draw();
-            }
-            for (auto& e : manager.getGroup(groupEnemies)) {
-                e->draw();
+            spriteBatch.Begin();
+            drawVisible(manager.getGroup(groupObjects));
+            drawVisible(manager.getGroup(groupNPCs));
+            drawVisible(manager.getGroup(groupPlayers));
+            drawVisible(manager.getGroup(groupProjectiles));
+            drawVisible(manager.getGroup(groupEnemies));
+            spriteBatch.Flush(renderer);
+            renderStats.drawCalls += spriteBatch.GetStats().drawCalls;
+            if (renderStatsReport) {
+                reportRenderStats();
             }
             
             for (auto& ui : manager.getGroup(groupUI)) {
@@ -1703,16 +1787,17 @@ void Game::render() {
                     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 80);
                     SDL_RenderDrawRect(renderer, &promptRect);
                     
-                    static Entity* promptLabel = nullptr;
-                    if (promptLabel == nullptr) {
-                        promptLabel = &manager.addEntity();
+                    if (!promptLabel) {
+                        Entity& label = manager.addEntity();
                         SDL_Color dimWhite = {220, 220, 220, 255};
-                        promptLabel->addComponent<UILabel>(0, 0, "Press E", "font1", dimWhite);
+                        label.addComponent<UILabel>(0, 0, "Press E", "font1", dimWhite);
+                        promptLabel = &label;
                     }
                     
-                    int labelWidth = promptLabel->getComponent<UILabel>().GetWidth();
-                    promptLabel->getComponent<UILabel>().SetPosition(promptX - labelWidth/2, promptY - 10);
-                    promptLabel->draw();
+                    Entity* label = promptLabel;
+                    int labelWidth = label->getComponent<UILabel>().GetWidth();
+                    label->getComponent<UILabel>().SetPosition(promptX - labelWidth/2, promptY - 10);
+                    label->draw();
                     
                     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
                     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
@@ -1726,14 +1811,160 @@ void Game::render() {
     }
 }
 
+void Game::queryTerrain(const SDL_Rect& area, std::vector<SDL_Rect>& results) {
+    if (map == nullptr) {
+        results.clear();
+        return;
+    }
+
+    SDL_Rect expanded = {
+        area.x - terrainQueryMargin,
+        area.y - terrainQueryMargin,
+        area.w + terrainQueryMargin * 2,
+        area.h + terrainQueryMargin * 2
+    };
+    map->QueryColliders(expanded, results);
+}
+
+void Game::benchmarkBroadphase() {
+    std::vector<Entity*> candidates;
+    std::vector<SDL_Rect> tileCandidates;
+    std::vector<SDL_Rect> allTiles;
+    long long bruteForceHits = 0;
+
+    if (map != nullptr) {
+        map->QueryColliders(map->GetBounds(), allTiles);
+    }
+
+    SDL_Rect playerCol = player->getComponent<ColliderComponent>().collider;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (auto& c : allTiles) {
+        bruteForceHits += Collision::AABB(c, playerCol);
+    }
+    for (auto& o : *objects) {
+        bruteForceHits += Collision::AABB(o->getComponent<ColliderComponent>().collider, playerCol);
+    }
+    for (auto& e : *enemies) {
+        SDL_Rect enemyCol = e->getComponent<ColliderComponent>().collider;
+        for (auto& c : allTiles) {
+            bruteForceHits += Collision::AABB(c, enemyCol);
+        }
+        for (auto& p : *projectiles) {
+            bruteForceHits += Collision::AABB(p->getComponent<ColliderComponent>().collider, enemyCol);
+        }
+    }
+    Uint64 middle = SDL_GetPerformanceCounter();
+
+    long long testsBefore = objectGrid.testsPerformed + projectileGrid.testsPerformed +
+                            (map != nullptr ? map->cellsVisited : 0);
+
+    objectGrid.clear();
+    for (auto& o : *objects) {
+        objectGrid.insert(o, o->getComponent<ColliderComponent>().collider);
+    }
+    projectileGrid.clear();
+    for (auto& p : *projectiles) {
+        projectileGrid.insert(p, p->getComponent<ColliderComponent>().collider);
+    }
+
+    queryTerrain(playerCol, tileCandidates);
+    objectGrid.query(playerCol, candidates);
+    for (auto& e : *enemies) {
+        SDL_Rect enemyCol = e->getComponent<ColliderComponent>().collider;
+        queryTerrain(enemyCol, tileCandidates);
+        projectileGrid.query(enemyCol, candidates);
+    }
+    Uint64 end = SDL_GetPerformanceCounter();
+
+    long long testsAfter = objectGrid.testsPerformed + projectileGrid.testsPerformed +
+                           (map != nullptr ? map->cellsVisited : 0);
+
+    size_t enemyCount = enemies->size();
+    broadphaseStats.bruteForceTests += (allTiles.size() + objects->size()) +
+                                       enemyCount * (allTiles.size() + projectiles->size());
+    broadphaseStats.gridTests += testsAfter - testsBefore;
+    broadphaseStats.bruteForceTicks += middle - start;
+    broadphaseStats.gridTicks += end - middle;
+    broadphaseStats.frames++;
+
+    if (broadphaseStats.frames >= 300) {
+        double frames = broadphaseStats.frames;
+        double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+        printf("Broadphase over %d frames: grid %.1f tests/frame (%.4f ms), brute force %.1f tests/frame (%.4f ms), %lld overlaps in last frame\n",
+               broadphaseStats.frames,
+               broadphaseStats.gridTests / frames, broadphaseStats.gridTicks / ticksPerMs / frames,
+               broadphaseStats.bruteForceTests / frames, broadphaseStats.bruteForceTicks / ticksPerMs / frames,
+               bruteForceHits);
+        broadphaseStats = BroadphaseStats();
+    }
+}
+
+bool Game::isVisible(Entity* entity) const {
+    SDL_Rect bounds;
+
+    if (entity->hasComponent<TransformComponent>()) {
+        const TransformComponent& transform = entity->getComponent<TransformComponent>();
+        bounds.x = static_cast<int>(transform.position.x);
+        bounds.y = static_cast<int>(transform.position.y);
+        bounds.w = transform.width * transform.scale;
+        bounds.h = transform.height * transform.scale;
+    } else {
+        return true;
+    }
+
+    return bounds.x < camera.x + camera.w && bounds.x + bounds.w > camera.x &&
+           bounds.y < camera.y + camera.h && bounds.y + bounds.h > camera.y;
+}
+
+void Game::reportRenderStats() {
+    renderTotals.drawn += renderStats.drawn;
+    renderTotals.culled += renderStats.culled;
+    renderTotals.drawCalls += renderStats.drawCalls;
+    renderFrames++;
+
+    if (renderFrames >= 300) {
+        double frames = renderFrames;
+        printf("Sprites over %d frames: %.1f drawn/frame, %.1f culled/frame, %.1f batched draw calls/frame\n",
+               renderFrames, renderTotals.drawn / frames, renderTotals.culled / frames, renderTotals.drawCalls / frames);
+        renderTotals = RenderStats();
+        renderFrames = 0;
+    }
+}
+
+void Game::drawVisible(std::vector<Entity*>& group) {
+    // Each group is its own batch layer so groups keep their draw order after sorting by texture.
+    spriteBatch.NextLayer();
+    for (auto& e : group) {
+        if (isVisible(e)) {
+            e->draw();
+            renderStats.drawn++;
+        } else {
+            renderStats.culled++;
+        }
+    }
+}
+
 void Game::clean()
 {
+    positionRecorder.Close();
+    jobs.Wait(saveJob);
+    discardPrefetchedLevel();
+    jobs.Shutdown();
     SDL_DestroyWindow(window);
     SDL_DestroyRenderer(renderer);
     Mix_CloseAudio();
     Mix_Quit();
     TTF_Quit();
     SDL_Quit();
+    std::vector<JobSystem::WorkerStats> jobStats = jobs.GetStats();
+    for (std::size_t i = 0; i < jobStats.size(); i++) {
+        const JobSystem::WorkerStats& stats = jobStats[i];
+        std::string name = i + 1 < jobStats.size() ? "Worker " + std::to_string(i) : "Main thread";
+        printf("%s: %lld jobs (%lld stolen), busy %.3fs, %.1f%% utilization\n",
+               name.c_str(), stats.jobsRun, stats.steals, stats.busySeconds, stats.utilization * 100.0);
+    }
+    std::cout << "HUD labels rebuilt " << UILabel::boundRebuilds << " times, skipped " << UILabel::skippedRebuilds << " unchanged updates" << std::endl;
     std::cout << "Game cleaned" << std::endl;
 }
 
@@ -1763,6 +1994,7 @@ void Game::restart() {
     
     positionManager.resetPositions();
     
+    promptLabel = nullptr;
     manager.clear();
     
     if (map != nullptr) {
@@ -1918,6 +2150,8 @@ void Game::setLevelParameters(int level) {
 }
 
 void Game::loadLevel(int levelNum) {
+    promptLabel = nullptr;
+
     if (map != nullptr) {
         delete map;
         map = nullptr;
@@ -1929,6 +2163,7 @@ void Game::loadLevel(int levelNum) {
     
     if (assets) {
         assets->StopMusic();
+        assets->UseLevel(currentLevel, jobs);
         
         switch (currentLevel) {
             case 1:
@@ -1959,35 +2194,77 @@ void Game::loadLevel(int levelNum) {
     setLevelParameters(currentLevel);
     
     std::string terrainTexture = "terrainlvl" + std::to_string(levelNum);
-    std::string mapPath;
+    std::string mapPath = levelMapPath(levelNum);
     
-    if (currentLevel == 4 && level4MapChanged) {
-        mapPath = "./assets/lvl4/Level4MapAfter.map";
-    } else {
-        mapPath = "./assets/lvl" + std::to_string(levelNum) + "/Level" + std::to_string(levelNum) + "Map.map";
+    if (Game::assets->GetTexture(terrainTexture) == nullptr) {
+        discardPrefetchedLevel();
+        return;
     }
     
-    if (Game::assets->GetTexture(terrainTexture) == nullptr) {
+    // A map prepared during the transition fade only needs its chunks baked here.
+    if (prefetchedMap != nullptr && prefetchedLevel == levelNum && prefetchedMapPath == mapPath) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        jobs.Wait(mapPrefetch);
+        map = prefetchedMap;
+        prefetchedMap = nullptr;
+        map->BakeChunks();
+        printf("Swapped in prefetched level %d in %.2f ms\n", levelNum,
+               (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency());
         return;
     }
     
+    discardPrefetchedLevel();
     map = new Map(terrainTexture, 2, 32, manager);
     
     map->LoadMap(mapPath, 60, 34);
 }
 
+std::string Game::levelMapPath(int levelNum) const {
+    if (levelNum == 4 && level4MapChanged) {
+        return "./assets/lvl4/Level4MapAfter.map";
+    }
+    return "./assets/lvl" + std::to_string(levelNum) + "/Level" + std::to_string(levelNum) + "Map.map";
+}
+
+void Game::prefetchLevel(int levelNum) {
+    discardPrefetchedLevel();
+    if (levelNum < 1 || levelNum > maxLevels) {
+        return;
+    }
+
+    prefetchedLevel = levelNum;
+    prefetchedMapPath = levelMapPath(levelNum);
+    prefetchedMap = new Map("terrainlvl" + std::to_string(levelNum), 2, 32, manager);
+
+    Map* target = prefetchedMap;
+    std::string path = prefetchedMapPath;
+    mapPrefetch = jobs.Submit([target, path]() { target->LoadData(path, 60, 34); });
+    assets->PrefetchLevel(levelNum, jobs);
+}
+
+void Game::discardPrefetchedLevel() {
+    if (prefetchedMap == nullptr) {
+        return;
+    }
+    jobs.Wait(mapPrefetch);
+    delete prefetchedMap;
+    prefetchedMap = nullptr;
+}
+
 void Game::advanceToNextLevel() {
     gameState = STATE_GAME;
     
     assets->PlaySound("levelTransition", volumeLevel);
     
     transitionManager.startTransition(currentLevel, currentLevel + 1);
+    prefetchLevel(currentLevel + 1);
     
     if (transitionLabel == nullptr) {
         transitionLabel = &manager.addEntity();
         transitionLabel->addComponent<UILabel>(0, 0, "", "font2", white);
     }
     
+    positionRecorder.Flush();
     lastRecordedPosition = Vector2D(0, 0);
 }
 
@@ -2146,6 +2423,7 @@ void Game::startGame() {
 }
 
 void Game::loadGame() {
+    jobs.Wait(saveJob);
     std::ifstream saveFile("assets/savegame.bin", std::ios::binary);
     if (!saveFile.is_open()) {
         std::cout << "No save file found or could not open. Starting new game." << std::endl;
@@ -2324,7 +2602,7 @@ void Game::loadGame() {
         gameover = nullptr; clueCounter = nullptr; feedbackLabel = nullptr; scientist = nullptr;
         questionLabel = nullptr; answer1Label = nullptr; answer2Label = nullptr;
         answer3Label = nullptr; answer4Label = nullptr; questionBackground = nullptr;
-        timerLabel = nullptr; transitionLabel = nullptr;
+        timerLabel = nullptr; transitionLabel = nullptr; promptLabel = nullptr;
 
         currentLevel = loadedLevel;
         collectedClues = loadedClues;
@@ -2353,13 +2631,10 @@ void Game::loadGame() {
 
         setLevelParameters(currentLevel);
 
+        assets->UseLevel(currentLevel, jobs);
+
         std::string terrainTexture = "terrainlvl" + std::to_string(currentLevel);
-        std::string mapPath;
-        if (currentLevel == 4 && level4MapChanged) {
-            mapPath = "./assets/lvl4/Level4MapAfter.map";
-        } else {
-            mapPath = "./assets/lvl" + std::to_string(currentLevel) + "/Level" + std::to_string(currentLevel) + "Map.map";
-        }
+        std::string mapPath = levelMapPath(currentLevel);
 
         if (assets->GetTexture(terrainTexture) == nullptr) {
             std::cerr << "Error: Failed to find texture " << terrainTexture << " for loaded level. Starting new game." << std::endl;
@@ -2494,14 +2769,13 @@ void Game::loadGame() {
             return;
         }
 
-        tiles = &manager.getGroup(Game::groupMap);
         players = &manager.getGroup(Game::groupPlayers);
         enemies = &manager.getGroup(Game::groupEnemies);
-        colliders = &manager.getGroup(Game::groupColliders);
         projectiles = &manager.getGroup(Game::groupProjectiles);
         objects = &manager.getGroup(Game::groupObjects);
         ui = &manager.getGroup(Game::groupUI);
 
+        positionRecorder.Open("assets/position.bin", true);
         isRecordingPositions = true;
         lastRecordedPosition = player->getComponent<TransformComponent>().position;
 
@@ -2551,6 +2825,8 @@ void Game::loadGame() {
 }
 
 void Game::initEndScreen(bool victory) {
+    positionRecorder.Flush();
+    
     selectedEndOption = END_RESTART;
     endOptionSelected = false;
     endHighlightActive = false;
@@ -2868,11 +3144,13 @@ void Game::updatePauseMenu() {
 }
 
 void Game::renderPauseMenu() {
-    for(auto& t : *tiles) t->draw();
-    for(auto& p : *players) p->draw();
-    for(auto& e : *enemies) e->draw();
-    for(auto& o : *objects) o->draw();
-    for(auto& p : *projectiles) p->draw();
+    if (map != nullptr) map->DrawMap();
+    spriteBatch.Begin();
+    drawVisible(*players);
+    drawVisible(*enemies);
+    drawVisible(*objects);
+    drawVisible(*projectiles);
+    spriteBatch.Flush(renderer);
     
     if (scientist != nullptr && scientist->isActive()) {
         scientist->draw();
@@ -2910,8 +3188,10 @@ void Game::saveGame() {
         return;
     }
 
-    std::ofstream saveFile("assets/savegame.bin", std::ios::binary | std::ios::trunc);
-    if (!saveFile.is_open()) {
+    jobs.Wait(saveJob);
+    // The file is opened here so a failure still reaches the player; writing it out runs on the job system.
+    auto saveFile = std::make_shared<std::ofstream>("assets/savegame.bin", std::ios::binary | std::ios::trunc);
+    if (!saveFile->is_open()) {
         std::cerr << "Error: Could not open savegame.bin for writing!" << std::endl;
         return;
     }
@@ -2956,46 +3236,50 @@ void Game::saveGame() {
         }
     }
 
-    saveFile.write(reinterpret_cast<const char*>(&pX), sizeof(pX));
-    saveFile.write(reinterpret_cast<const char*>(&pY), sizeof(pY));
-    saveFile.write(reinterpret_cast<const char*>(&pHealth), sizeof(pHealth));
-    saveFile.write(reinterpret_cast<const char*>(&pCurrentAmmo), sizeof(pCurrentAmmo));
-    saveFile.write(reinterpret_cast<const char*>(&pMaxAmmo), sizeof(pMaxAmmo));
+    std::ostringstream saveData(std::ios::binary);
+    saveData.write(reinterpret_cast<const char*>(&pX), sizeof(pX));
+    saveData.write(reinterpret_cast<const char*>(&pY), sizeof(pY));
+    saveData.write(reinterpret_cast<const char*>(&pHealth), sizeof(pHealth));
+    saveData.write(reinterpret_cast<const char*>(&pCurrentAmmo), sizeof(pCurrentAmmo));
+    saveData.write(reinterpret_cast<const char*>(&pMaxAmmo), sizeof(pMaxAmmo));
     
-    writeString(saveFile, playerName);
+    writeString(saveData, playerName);
 
-    saveFile.write(reinterpret_cast<const char*>(&collectedClues), sizeof(collectedClues));
-    saveFile.write(reinterpret_cast<const char*>(&currentLevel), sizeof(currentLevel));
-    saveFile.write(reinterpret_cast<const char*>(&gameplayTime), sizeof(gameplayTime));
-    saveFile.write(reinterpret_cast<const char*>(&level4MapChanged), sizeof(level4MapChanged));
-    saveFile.write(reinterpret_cast<const char*>(&finalBossDefeated), sizeof(finalBossDefeated));
-    saveFile.write(reinterpret_cast<const char*>(&scientistRescued), sizeof(scientistRescued));
-    saveFile.write(reinterpret_cast<const char*>(&canRescueScientist), sizeof(canRescueScientist));
+    saveData.write(reinterpret_cast<const char*>(&collectedClues), sizeof(collectedClues));
+    saveData.write(reinterpret_cast<const char*>(&currentLevel), sizeof(currentLevel));
+    saveData.write(reinterpret_cast<const char*>(&gameplayTime), sizeof(gameplayTime));
+    saveData.write(reinterpret_cast<const char*>(&level4MapChanged), sizeof(level4MapChanged));
+    saveData.write(reinterpret_cast<const char*>(&finalBossDefeated), sizeof(finalBossDefeated));
+    saveData.write(reinterpret_cast<const char*>(&scientistRescued), sizeof(scientistRescued));
+    saveData.write(reinterpret_cast<const char*>(&canRescueScientist), sizeof(canRescueScientist));
 
     size_t numUsedQuestions = questionsToSave.size();
-    saveFile.write(reinterpret_cast<const char*>(&numUsedQuestions), sizeof(numUsedQuestions));
+    saveData.write(reinterpret_cast<const char*>(&numUsedQuestions), sizeof(numUsedQuestions));
     for (int questionIndex : questionsToSave) {
-        saveFile.write(reinterpret_cast<const char*>(&questionIndex), sizeof(questionIndex));
+        saveData.write(reinterpret_cast<const char*>(&questionIndex), sizeof(questionIndex));
     }
 
     size_t numEnemies = enemiesToSave.size();
-    saveFile.write(reinterpret_cast<const char*>(&numEnemies), sizeof(numEnemies));
+    saveData.write(reinterpret_cast<const char*>(&numEnemies), sizeof(numEnemies));
     for (const auto& data : enemiesToSave) {
-        saveFile.write(reinterpret_cast<const char*>(&data.x), sizeof(float));
-        saveFile.write(reinterpret_cast<const char*>(&data.y), sizeof(float));
-        saveFile.write(reinterpret_cast<const char*>(&data.health), sizeof(int));
-        saveFile.write(reinterpret_cast<const char*>(&data.isBoss), sizeof(bool));
+        saveData.write(reinterpret_cast<const char*>(&data.x), sizeof(float));
+        saveData.write(reinterpret_cast<const char*>(&data.y), sizeof(float));
+        saveData.write(reinterpret_cast<const char*>(&data.health), sizeof(int));
+        saveData.write(reinterpret_cast<const char*>(&data.isBoss), sizeof(bool));
     }
 
     size_t numObjects = objectsToSave.size();
-    saveFile.write(reinterpret_cast<const char*>(&numObjects), sizeof(numObjects));
+    saveData.write(reinterpret_cast<const char*>(&numObjects), sizeof(numObjects));
     for (const auto& data : objectsToSave) {
-        saveFile.write(reinterpret_cast<const char*>(&data.x), sizeof(float));
-        saveFile.write(reinterpret_cast<const char*>(&data.y), sizeof(float));
-        writeString(saveFile, data.type);
+        saveData.write(reinterpret_cast<const char*>(&data.x), sizeof(float));
+        saveData.write(reinterpret_cast<const char*>(&data.y), sizeof(float));
+        writeString(saveData, data.type);
     }
 
-    saveFile.close();
+    saveJob = jobs.Submit([saveFile, data = saveData.str()]() {
+        saveFile->write(data.data(), data.size());
+        saveFile->close();
+    });
 
     std::cout << "Game saved successfully." << std::endl;
 
@@ -3105,11 +3389,13 @@ void Game::updateSettingsMenu() {
 
 void Game::renderSettingsMenu() {
     if (previousState == STATE_PAUSE) {
-        for(auto& t : *tiles) t->draw();
-        for(auto& p : *players) p->draw();
-        for(auto& e : *enemies) e->draw();
-        for(auto& o : *objects) o->draw();
-        for(auto& p : *projectiles) p->draw();
+        if (map != nullptr) map->DrawMap();
+        spriteBatch.Begin();
+        drawVisible(*players);
+        drawVisible(*enemies);
+        drawVisible(*objects);
+        drawVisible(*projectiles);
+        spriteBatch.Flush(renderer);
         
         if (scientist != nullptr && scientist->isActive()) {
             scientist->draw();
@@ -3164,29 +3450,17 @@ void Game::renderSettingsMenu() {
     if (keybindsLabel) {
         keybindsLabel->draw();
         
-        TTF_Font* font = assets->GetFont("font1");
-        if (font) {
+        GlyphAtlas* atlas = assets->GetGlyphAtlas("font1");
+        if (atlas) {
             int yOffset = 450;
             int screenCenter = 1920 / 2;
             
             for (const auto& keybind : keybinds) {
                 std::string bindText = keybind.action + ": " + keybind.key;
                 
-                SDL_Surface* textSurface = TTF_RenderText_Solid(font, bindText.c_str(), white);
-                if (textSurface) {
-                    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                    if (textTexture) {
-                        int textWidth = textSurface->w;
-                        int textHeight = textSurface->h;
-                        int xPos = screenCenter - (textWidth / 2);
-                        
-                        SDL_Rect destRect = {xPos, yOffset, textWidth, textHeight};
-                        SDL_RenderCopy(renderer, textTexture, NULL, &destRect);
-                        
-                        SDL_DestroyTexture(textTexture);
-                    }
-                    SDL_FreeSurface(textSurface);
-                }
+                int textWidth, textHeight;
+                atlas->BuildQuads(bindText, white, keybindVertices, textWidth, textHeight);
+                atlas->Draw(keybindVertices, screenCenter - (textWidth / 2), yOffset);
                 
                 yOffset += 45;
             }
@@ -3229,34 +3503,14 @@ void Game::readAllPositionsFromFile() {
     replayPositionIndex = 0;           
     currentReplayLevel = 1;            
 
-    std::ifstream posFile("assets/position.txt");
-    if (!posFile.is_open()) {
+    positionRecorder.Sync();
+    if (!PositionRecorder::Load("assets/position.bin", allReplayPositionsByLevel)) {
         std::cerr << "Failed to open position file for replay!" << std::endl;
         isReplaying = false; 
         return;
     }
 
-    std::string line;
-    int minLevelFound = -1; 
-
-    while (std::getline(posFile, line)) {
-        std::stringstream ss(line);
-        std::string xStr, yStr, lvlStr;
-        if (std::getline(ss, xStr, ',') && std::getline(ss, yStr, ',') && std::getline(ss, lvlStr, ',')) {
-            try {
-                int x = std::stoi(xStr); int y = std::stoi(yStr); int lvl = std::stoi(lvlStr);
-                allReplayPositionsByLevel[lvl].push_back(Vector2D(x, y));
-                if (minLevelFound == -1 || lvl < minLevelFound) { minLevelFound = lvl; }
-            } catch (const std::exception&) { /* Skip */ }
-        } else {
-             std::stringstream oldFormat(line); int x, y, lvl;
-             if (oldFormat >> x >> y >> lvl) {
-                 allReplayPositionsByLevel[lvl].push_back(Vector2D(x, y));
-                 if (minLevelFound == -1 || lvl < minLevelFound) { minLevelFound = lvl; }
-             }
-        }
-    }
-    posFile.close();
+    int minLevelFound = allReplayPositionsByLevel.empty() ? -1 : allReplayPositionsByLevel.begin()->first;
 
     if (allReplayPositionsByLevel.empty()) {
         std::cerr << "No valid positions found in position file." << std::endl;
@@ -3316,7 +3570,7 @@ void Game::updateReplay() {
 
 void Game::renderReplay() {
     SDL_RenderClear(renderer);
-    for(auto& t : *tiles) t->draw();
+    if (map != nullptr) map->DrawMap();
 
     if (replayEntity && replayEntity->hasComponent<TransformComponent>()) {
         replayEntity->draw();
@@ -3337,16 +3591,8 @@ void Game::recordPlayerPosition() {
         if (std::abs(currentPosition.x - lastRecordedPosition.x) >= recordThreshold || 
             std::abs(currentPosition.y - lastRecordedPosition.y) >= recordThreshold) {
             
-            std::ofstream positionFile("assets/position.txt", std::ios::app);
-            
-            if (positionFile.is_open()) {
-                positionFile << static_cast<int>(currentPosition.x) << "," 
-                             << static_cast<int>(currentPosition.y) << "," 
-                             << currentLevel << std::endl;
-                
-                lastRecordedPosition = currentPosition;
-            }
-            positionFile.close();
+            positionRecorder.Append(static_cast<int>(currentPosition.x), static_cast<int>(currentPosition.y), currentLevel);
+            lastRecordedPosition = currentPosition;
         }
     }
 }
@@ -3450,8 +3696,7 @@ void Game::promptPlayerName() {
     
     resetUsedQuestions();
     
-    std::ofstream positionFile("assets/position.txt", std::ios::trunc);
-    positionFile.close();
+    positionRecorder.Open("assets/position.bin", false);
     isRecordingPositions = true;
     lastRecordedPosition = Vector2D(0, 0);
     
@@ -3480,6 +3725,7 @@ void Game::promptPlayerName() {
     answer3Label = nullptr;
     answer4Label = nullptr;
     questionBackground = nullptr;
+    promptLabel = nullptr;
     
     manager.clear();
     
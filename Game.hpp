@@ -11,15 +11,19 @@
 #include "Vector2D.hpp"
 #include "RandomPositionManager.hpp"
 #include "TransitionManager.hpp"
+#include "SpatialHash.hpp"
+#include "PositionRecorder.hpp"
+#include "JobSystem.hpp"
+#include "SpriteBatch.hpp"
 #include <map>
 
 class ColliderComponent;
 class AssetManager;
 class Map;
 
-extern Entity* player;
-extern Entity* finalBoss;
-extern Entity* scientist;
+extern EntityRef player;
+extern EntityRef finalBoss;
+extern EntityRef scientist;
 
 enum GameState {
     STATE_MAIN_MENU,
@@ -73,6 +77,8 @@ class Game {
         void handleEvents();
         void update();
         void render();
+        void renderLoadingProgress(int loaded, int total);
+        void renderFrame();
         void clean();
         void restart();
         void replay();
@@ -90,6 +96,10 @@ class Game {
         void loadGame();
 
         void loadLevel(int levelNum);
+        // Prepares the next level's map and assets on the job system while the transition fades.
+        void prefetchLevel(int levelNum);
+        void discardPrefetchedLevel();
+        std::string levelMapPath(int levelNum) const;
         void advanceToNextLevel();
         
         void initEndScreen(bool victory);
@@ -118,18 +128,29 @@ class Game {
         static SDL_Event event;
         static bool isRunning;
         static SDL_Rect camera;
+        static float renderAlpha;
+        static constexpr float fixedTimestep = 1.0f / 60.0f;
+
+        struct RenderStats {
+            int drawn = 0;
+            int culled = 0;
+            int drawCalls = 0;
+        };
+        static RenderStats renderStats;
+        static SpriteBatch spriteBatch;
         static AssetManager* assets;
         static int totalClues;
         static int totalMagazines;
         static int totalHealthPotions;
         static int collectedClues;
         static bool gameOver;
+        static bool debugColliders;
         static bool playerWon;
         static bool questionActive;
-        static Entity* pendingClueEntity;
+        static EntityRef pendingClueEntity;
         static bool showFeedback;
         static Uint32 feedbackStartTime;
-        static Entity* feedbackLabel;
+        static EntityRef feedbackLabel;
         static int currentLevel;
         static int maxLevels;
         static bool showingExitInstructions;
@@ -152,7 +173,7 @@ class Game {
 
         static Uint32 gameStartTime;
         static Uint32 gameplayTime;
-        static Entity* timerLabel;
+        static EntityRef timerLabel;
 
         std::set<int> usedQuestions;
         int currentQuestion = -1;
@@ -172,13 +193,15 @@ class Game {
         
         static std::string currentMusic;
 
-        Entity* replayEntity = nullptr;
+        EntityRef replayEntity = nullptr;
         std::map<int, std::vector<Vector2D>> allReplayPositionsByLevel;
         int currentReplayLevel = 1;
 
     private:
         int count = 0;
-        Uint32 lastTime = 0;
+        SDL_Rect previousCamera = { 0, 0, 0, 0 };
+
+        void snapshotTransforms();
         SDL_Window* window;
         SDL_Color white = {255, 255, 255, 255};
         SDL_Color green = {0, 255, 0, 255};
@@ -191,13 +214,13 @@ class Game {
         float hurtSoundTimer = 0.0f;
         const float hurtSoundCooldown = 0.5f;
         
-        Entity* menuTitle = nullptr;
-        Entity* menuNewGameButton = nullptr;
-        Entity* menuLoadGameButton = nullptr;
-        Entity* menuSettingsButton = nullptr;
-        Entity* menuLeaderboardButton = nullptr;
-        Entity* menuExitButton = nullptr;
-        Entity* menuBackground = nullptr;
+        EntityRef menuTitle = nullptr;
+        EntityRef menuNewGameButton = nullptr;
+        EntityRef menuLoadGameButton = nullptr;
+        EntityRef menuSettingsButton = nullptr;
+        EntityRef menuLeaderboardButton = nullptr;
+        EntityRef menuExitButton = nullptr;
+        EntityRef menuBackground = nullptr;
         
         int selectedMenuItem = MENU_NEW_GAME;
         bool menuItemSelected = false;
@@ -207,11 +230,11 @@ class Game {
         bool endOptionSelected = false;
         bool endHighlightActive = false;
         
-        Entity* endTitle = nullptr;
-        Entity* endMessage = nullptr;
-        Entity* endRestartButton = nullptr;
-        Entity* endReplayButton = nullptr;
-        Entity* endMenuButton = nullptr;
+        EntityRef endTitle = nullptr;
+        EntityRef endMessage = nullptr;
+        EntityRef endRestartButton = nullptr;
+        EntityRef endReplayButton = nullptr;
+        EntityRef endMenuButton = nullptr;
         
         RandomPositionManager positionManager;
         TransitionManager transitionManager;
@@ -224,38 +247,78 @@ class Game {
         
         std::vector<Question> questions;
         
-        Entity* questionLabel = nullptr;
-        Entity* answer1Label = nullptr;
-        Entity* answer2Label = nullptr;
-        Entity* answer3Label = nullptr;
-        Entity* answer4Label = nullptr;
-        Entity* questionBackground = nullptr;
-        Entity* transitionLabel = nullptr;
+        EntityRef questionLabel = nullptr;
+        EntityRef answer1Label = nullptr;
+        EntityRef answer2Label = nullptr;
+        EntityRef answer3Label = nullptr;
+        EntityRef answer4Label = nullptr;
+        EntityRef questionBackground = nullptr;
+        EntityRef transitionLabel = nullptr;
+        EntityRef promptLabel = nullptr;
 
         void resetUsedQuestions() { usedQuestions.clear(); }
+
+        bool isVisible(Entity* entity) const;
+        void drawVisible(std::vector<Entity*>& group);
+        std::vector<SDL_Vertex> keybindVertices;
+
+        struct BroadphaseStats {
+            long long gridTests = 0;
+            long long bruteForceTests = 0;
+            Uint64 gridTicks = 0;
+            Uint64 bruteForceTicks = 0;
+            int frames = 0;
+        };
+
+        SpatialHash objectGrid{128};
+        SpatialHash projectileGrid{128};
+        std::vector<Entity*> nearbyEntities;
+        std::vector<SDL_Rect> nearbyTiles;
+        bool broadphaseBenchmark = false;
+        BroadphaseStats broadphaseStats;
+        const int terrainQueryMargin = 16;
+
+        void queryTerrain(const SDL_Rect& area, std::vector<SDL_Rect>& results);
+        void benchmarkBroadphase();
+
+        bool renderStatsReport = false;
+        RenderStats renderTotals;
+        int renderFrames = 0;
+
+        void reportRenderStats();
         
+        PositionRecorder positionRecorder;
+        JobSystem jobs;
+        // Level textures and music beyond this are evicted once their level is left.
+        static constexpr std::size_t assetMemoryBudget = 8 * 1024 * 1024;
+        JobHandle saveJob;
+        Map* prefetchedMap = nullptr;
+        int prefetchedLevel = 0;
+        std::string prefetchedMapPath;
+        JobHandle mapPrefetch;
+
         void recordPlayerPosition();
         void readAllPositionsFromFile();
         void updateReplay();
         void renderReplay();
 
-        Entity* pauseTitle = nullptr;
-        Entity* pauseResumeButton = nullptr;
-        Entity* pauseSaveButton = nullptr;
-        Entity* pauseRestartButton = nullptr;
-        Entity* pauseSettingsButton = nullptr;
-        Entity* pauseMainMenuButton = nullptr;
-        Entity* pauseBackground = nullptr;
+        EntityRef pauseTitle = nullptr;
+        EntityRef pauseResumeButton = nullptr;
+        EntityRef pauseSaveButton = nullptr;
+        EntityRef pauseRestartButton = nullptr;
+        EntityRef pauseSettingsButton = nullptr;
+        EntityRef pauseMainMenuButton = nullptr;
+        EntityRef pauseBackground = nullptr;
         
         int selectedPauseItem = PAUSE_RESUME;
         bool pauseItemSelected = false;
         bool pauseHighlightActive = false;
         
-        Entity* settingsTitle = nullptr;
-        Entity* volumeLabel = nullptr;
-        Entity* keybindsLabel = nullptr;
-        Entity* settingsBackButton = nullptr;
-        Entity* settingsBackground = nullptr;
+        EntityRef settingsTitle = nullptr;
+        EntityRef volumeLabel = nullptr;
+        EntityRef keybindsLabel = nullptr;
+        EntityRef settingsBackButton = nullptr;
+        EntityRef settingsBackground = nullptr;
         
         int selectedSettingsItem = SETTINGS_VOLUME;
         bool settingsItemSelected = false;
@@ -274,7 +337,8 @@ class Game {
             {"Move Right", "D"},
             {"Shoot", "Left Mouse"},
             {"Interact/Skip Question", "E"},
-            {"Pause", "ESC"}
+            {"Pause", "ESC"},
+            {"Toggle Collider Debug", "F1"}
         };
 
         GameState previousState = STATE_MAIN_MENU;
@@ -284,8 +348,8 @@ class Game {
         bool shouldSaveToLeaderboard = false;
         std::vector<std::pair<std::string, std::string>> leaderboardEntries;
         
-        Entity* leaderboardTitle = nullptr;
-        Entity* leaderboardEntryLabels[5] = {nullptr};
-        Entity* leaderboardBackButton = nullptr;
+        EntityRef leaderboardTitle = nullptr;
+        EntityRef leaderboardEntryLabels[5] = {nullptr};
+        EntityRef leaderboardBackButton = nullptr;
 };
 #endif
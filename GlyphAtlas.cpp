@@ -0,0 +1,154 @@
+#include "GlyphAtlas.hpp"
+#include <iostream>
+#include <algorithm>
+
+GlyphAtlas::GlyphAtlas(TTF_Font* f, SDL_Renderer* ren) : font(f), renderer(ren) {
+    for (auto& glyph : glyphs) {
+        glyph = { { 0, 0, 0, 0 }, 0, false };
+    }
+
+    if (font == nullptr || renderer == nullptr) {
+        return;
+    }
+
+    lineHeight = TTF_FontHeight(font);
+
+    SDL_Surface* rendered[lastChar - firstChar + 1] = {};
+    const int maxRowWidth = 1024;
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+
+    for (int c = firstChar; c <= lastChar; c++) {
+        Glyph& glyph = glyphs[c - firstChar];
+        int minx, maxx, miny, maxy, advance;
+        if (TTF_GlyphMetrics32(font, c, &minx, &maxx, &miny, &maxy, &advance) != 0) {
+            continue;
+        }
+        glyph.advance = advance;
+        glyph.present = true;
+
+        if (c == ' ') {
+            continue;
+        }
+
+        // Glyphs are rendered white so label colors can be applied as vertex colors.
+        SDL_Surface* surf = TTF_RenderGlyph32_Blended(font, c, { 255, 255, 255, 255 });
+        if (surf == nullptr) {
+            continue;
+        }
+
+        if (penX + surf->w > maxRowWidth) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+
+        glyph.src = { penX, penY, surf->w, surf->h };
+        rendered[c - firstChar] = surf;
+        penX += surf->w + 1;
+        rowHeight = std::max(rowHeight, surf->h);
+        atlasWidth = std::max(atlasWidth, penX);
+    }
+    atlasHeight = penY + rowHeight;
+
+    if (atlasWidth == 0 || atlasHeight == 0) {
+        return;
+    }
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (atlas != nullptr) {
+        SDL_FillRect(atlas, nullptr, SDL_MapRGBA(atlas->format, 255, 255, 255, 0));
+        for (int i = 0; i <= lastChar - firstChar; i++) {
+            if (rendered[i] == nullptr) {
+                continue;
+            }
+            SDL_SetSurfaceBlendMode(rendered[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(rendered[i], nullptr, atlas, &glyphs[i].src);
+        }
+
+        texture = SDL_CreateTextureFromSurface(renderer, atlas);
+        if (texture != nullptr) {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        } else {
+            std::cout << "Failed to create glyph atlas texture: " << SDL_GetError() << std::endl;
+        }
+        SDL_FreeSurface(atlas);
+    }
+
+    for (auto surf : rendered) {
+        if (surf != nullptr) {
+            SDL_FreeSurface(surf);
+        }
+    }
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    if (texture != nullptr) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void GlyphAtlas::BuildQuads(const std::string& text, SDL_Color color, std::vector<SDL_Vertex>& vertices, int& width, int& height) const {
+    vertices.clear();
+    width = 0;
+    height = text.empty() ? 0 : lineHeight;
+
+    int penX = 0;
+    int previous = 0;
+
+    for (unsigned char ch : text) {
+        int c = (ch < firstChar || ch > lastChar) ? '?' : ch;
+        const Glyph& glyph = glyphs[c - firstChar];
+        if (!glyph.present) {
+            continue;
+        }
+
+        if (previous != 0) {
+            penX += TTF_GetFontKerningSizeGlyphs32(font, previous, c);
+        }
+        previous = c;
+
+        if (glyph.src.w > 0 && glyph.src.h > 0) {
+            float u0 = static_cast<float>(glyph.src.x) / atlasWidth;
+            float v0 = static_cast<float>(glyph.src.y) / atlasHeight;
+            float u1 = static_cast<float>(glyph.src.x + glyph.src.w) / atlasWidth;
+            float v1 = static_cast<float>(glyph.src.y + glyph.src.h) / atlasHeight;
+            float x0 = static_cast<float>(penX);
+            float x1 = static_cast<float>(penX + glyph.src.w);
+            float y1 = static_cast<float>(glyph.src.h);
+
+            vertices.push_back({ { x0, 0.0f }, color, { u0, v0 } });
+            vertices.push_back({ { x1, 0.0f }, color, { u1, v0 } });
+            vertices.push_back({ { x1, y1 }, color, { u1, v1 } });
+            vertices.push_back({ { x0, y1 }, color, { u0, v1 } });
+        }
+
+        penX += glyph.advance;
+        width = std::max(width, penX);
+    }
+}
+
+void GlyphAtlas::Draw(const std::vector<SDL_Vertex>& vertices, int x, int y) {
+    if (texture == nullptr || vertices.empty()) {
+        return;
+    }
+
+    drawVertices.assign(vertices.begin(), vertices.end());
+    for (auto& vertex : drawVertices) {
+        vertex.position.x += x;
+        vertex.position.y += y;
+    }
+
+    size_t quads = drawVertices.size() / 4;
+    if (drawIndices.size() < quads * 6) {
+        drawIndices.clear();
+        for (size_t q = 0; q < quads; q++) {
+            int base = static_cast<int>(q * 4);
+            drawIndices.insert(drawIndices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+    }
+
+    SDL_RenderGeometry(renderer, texture, drawVertices.data(), static_cast<int>(drawVertices.size()),
+                       drawIndices.data(), static_cast<int>(quads * 6));
+}
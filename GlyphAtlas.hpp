@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_ttf.h"
+
+class GlyphAtlas {
+    public:
+        GlyphAtlas(TTF_Font* font, SDL_Renderer* renderer);
+        ~GlyphAtlas();
+
+        void BuildQuads(const std::string& text, SDL_Color color, std::vector<SDL_Vertex>& vertices, int& width, int& height) const;
+        void Draw(const std::vector<SDL_Vertex>& vertices, int x, int y);
+
+        SDL_Texture* GetTexture() const { return texture; }
+
+    private:
+        struct Glyph {
+            SDL_Rect src;
+            int advance;
+            bool present;
+        };
+
+        static const int firstChar = 32;
+        static const int lastChar = 126;
+
+        TTF_Font* font;
+        SDL_Renderer* renderer;
+        SDL_Texture* texture = nullptr;
+        int atlasWidth = 0;
+        int atlasHeight = 0;
+        int lineHeight = 0;
+        Glyph glyphs[lastChar - firstChar + 1];
+
+        std::vector<SDL_Vertex> drawVertices;
+        std::vector<int> drawIndices;
+};
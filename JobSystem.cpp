@@ -0,0 +1,259 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+
+namespace {
+    thread_local int currentWorker = -1;
+    thread_local const JobSystem* currentSystem = nullptr;
+    thread_local int executeDepth = 0;
+}
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount <= 0) {
+        workerCount = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+    }
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+
+    for (int i = 0; i < workerCount; i++) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (int i = 0; i <= workerCount; i++) {
+        counters.emplace_back(new Counters());
+    }
+    statsStart = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+JobHandle JobSystem::Submit(Job job) {
+    JobHandle handle;
+    handle.state = NewState(1);
+    Enqueue(handle.state, std::move(job));
+    return handle;
+}
+
+JobHandle JobSystem::Then(const JobHandle& parent, Job job) {
+    JobHandle handle;
+    handle.state = NewState(1);
+
+    if (parent.state != nullptr) {
+        std::lock_guard<std::mutex> lock(parent.state->mutex);
+        if (!parent.state->done) {
+            std::shared_ptr<JobHandle::State> state = handle.state;
+            parent.state->continuations.push_back([this, state, job]() { Enqueue(state, job); });
+            return handle;
+        }
+    }
+
+    Enqueue(handle.state, std::move(job));
+    return handle;
+}
+
+JobHandle JobSystem::ParallelFor(std::size_t count, std::size_t grain, RangeJob body) {
+    if (grain == 0) {
+        grain = 1;
+    }
+    std::size_t chunks = (count + grain - 1) / grain;
+
+    JobHandle handle;
+    handle.state = NewState(static_cast<int>(chunks));
+    if (chunks == 0) {
+        Complete(handle.state);
+        return handle;
+    }
+
+    // Chunks share one copy of the body rather than copying its captures per chunk.
+    auto shared = std::make_shared<RangeJob>(std::move(body));
+    for (std::size_t begin = 0; begin < count; begin += grain) {
+        std::size_t end = std::min(count, begin + grain);
+        Push([this, state = handle.state, shared, begin, end]() {
+            (*shared)(begin, end);
+            Complete(state);
+        });
+    }
+    return handle;
+}
+
+void JobSystem::Wait(const JobHandle& handle) {
+    while (!handle.IsDone()) {
+        if (!RunPending()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::RunPending() {
+    Job job;
+    int self = (currentSystem == this) ? currentWorker : -1;
+    int slot = self >= 0 ? self : static_cast<int>(workers.size());
+
+    if (self >= 0 && PopLocal(self, job)) {
+        Execute(job, slot, false);
+        return true;
+    }
+    if (Steal(self, job)) {
+        Execute(job, slot, true);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        if (stopping) {
+            return;
+        }
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+std::vector<JobSystem::WorkerStats> JobSystem::GetStats() const {
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - statsStart).count();
+
+    std::vector<WorkerStats> stats;
+    for (const auto& c : counters) {
+        WorkerStats s;
+        s.jobsRun = c->jobsRun;
+        s.steals = c->steals;
+        s.busySeconds = c->busyMicros / 1000000.0;
+        s.utilization = elapsed > 0.0 ? s.busySeconds / elapsed : 0.0;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+void JobSystem::ResetStats() {
+    for (auto& c : counters) {
+        c->jobsRun = 0;
+        c->steals = 0;
+        c->busyMicros = 0;
+    }
+    statsStart = std::chrono::steady_clock::now();
+}
+
+std::shared_ptr<JobHandle::State> JobSystem::NewState(int pending) {
+    auto state = std::make_shared<JobHandle::State>();
+    state->pending = pending;
+    return state;
+}
+
+void JobSystem::Enqueue(const std::shared_ptr<JobHandle::State>& state, Job job) {
+    Push([this, state, job = std::move(job)]() {
+        job();
+        Complete(state);
+    });
+}
+
+void JobSystem::Push(Job job) {
+    // Workers push onto their own queue so nested work stays cache-local; other threads spread jobs round-robin.
+    int index = (currentSystem == this) ? currentWorker
+                                        : static_cast<int>(nextQueue++ % queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(std::move(job));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedJobs++;
+    }
+    wake.notify_one();
+}
+
+void JobSystem::Complete(const std::shared_ptr<JobHandle::State>& state) {
+    if (--state->pending > 0) {
+        return;
+    }
+
+    std::vector<std::function<void()>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done = true;
+        continuations.swap(state->continuations);
+    }
+    for (auto& continuation : continuations) {
+        continuation();
+    }
+}
+
+void JobSystem::Execute(Job& job, int slot, bool stolen) {
+    auto start = std::chrono::steady_clock::now();
+    executeDepth++;
+    job();
+    executeDepth--;
+
+    Counters& c = *counters[slot];
+    c.jobsRun++;
+    // Jobs run while another job waits are already inside the outer job's busy time.
+    if (executeDepth == 0) {
+        c.busyMicros += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+    if (stolen) {
+        c.steals++;
+    }
+}
+
+void JobSystem::WorkerLoop(int index) {
+    currentWorker = index;
+    currentSystem = this;
+
+    while (true) {
+        if (RunPending()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queuedJobs > 0; });
+        if (stopping && queuedJobs == 0) {
+            return;
+        }
+    }
+}
+
+bool JobSystem::PopLocal(int index, Job& job) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    queuedJobs--;
+    return true;
+}
+
+bool JobSystem::Steal(int thief, Job& job) {
+    int count = static_cast<int>(queues.size());
+    int start = thief >= 0 ? thief + 1 : 0;
+
+    for (int i = 0; i < count; i++) {
+        int victim = (start + i) % count;
+        if (victim == thief) {
+            continue;
+        }
+
+        WorkerQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queuedJobs--;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+class JobSystem;
+
+// Shared completion state of a submitted job, continuation or parallel-for.
+// A default-constructed handle counts as already done.
+class JobHandle {
+    friend class JobSystem;
+
+    public:
+        JobHandle() {}
+
+        bool IsValid() const { return state != nullptr; }
+        bool IsDone() const { return state == nullptr || state->done; }
+
+    private:
+        struct State {
+            std::atomic<int> pending{1};
+            std::atomic<bool> done{false};
+            std::mutex mutex;
+            std::vector<std::function<void()>> continuations;
+        };
+
+        std::shared_ptr<State> state;
+};
+
+class JobSystem {
+    public:
+        using Job = std::function<void()>;
+        using RangeJob = std::function<void(std::size_t begin, std::size_t end)>;
+
+        struct WorkerStats {
+            long long jobsRun = 0;
+            long long steals = 0;
+            double busySeconds = 0.0;
+            double utilization = 0.0;
+        };
+
+        JobSystem(int workerCount = 0);
+        ~JobSystem();
+
+        JobHandle Submit(Job job);
+        // Runs job once parent has finished; chains can be built by passing the returned handle on.
+        JobHandle Then(const JobHandle& parent, Job job);
+        // Splits [0, count) into chunks of at most grain items and runs body on each chunk.
+        JobHandle ParallelFor(std::size_t count, std::size_t grain, RangeJob body);
+        // Blocks until handle is done, running queued jobs on the calling thread meanwhile.
+        void Wait(const JobHandle& handle);
+
+        bool RunPending();
+        void Shutdown();
+
+        int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+
+        // One entry per worker followed by one for jobs run by other threads through RunPending/Wait.
+        std::vector<WorkerStats> GetStats() const;
+        void ResetStats();
+
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        struct Counters {
+            std::atomic<long long> jobsRun{0};
+            std::atomic<long long> steals{0};
+            std::atomic<long long> busyMicros{0};
+        };
+
+        static std::shared_ptr<JobHandle::State> NewState(int pending);
+        void Enqueue(const std::shared_ptr<JobHandle::State>& state, Job job);
+        void Push(Job job);
+        void Complete(const std::shared_ptr<JobHandle::State>& state);
+        void Execute(Job& job, int slot, bool stolen);
+
+        void WorkerLoop(int index);
+        bool PopLocal(int index, Job& job);
+        bool Steal(int thief, Job& job);
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::unique_ptr<Counters>> counters;
+        std::vector<std::thread> workers;
+        std::chrono::steady_clock::time_point statsStart;
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        std::atomic<int> queuedJobs{0};
+        std::atomic<unsigned int> nextQueue{0};
+        bool stopping = false;
+};
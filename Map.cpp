@@ -2,6 +2,9 @@
 #include "Game.hpp"
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include "MappedFile.hpp"
 #include "./ECS/ECS.hpp"
 #include "ECS/Components.hpp"
 
@@ -9,38 +12,144 @@ Map::Map(std::string tID, int ms, int ts, Manager& man) : texID(tID), mapScale(m
     scaledSize = ms * ts;
 }
 
+const char Map::binaryMagic[4] = { 'J', 'E', 'M', 'B' };
+const char Map::patchMagic[4] = { 'J', 'E', 'M', 'D' };
+
 Map::~Map() {
+    DestroyChunks();
+}
 
+namespace {
+    // Lets the map parser read a packed entry in place instead of copying it into a stringstream.
+    class MemoryBuffer : public std::streambuf {
+        public:
+            MemoryBuffer(const Uint8* bytes, std::size_t size) {
+                char* begin = const_cast<char*>(reinterpret_cast<const char*>(bytes));
+                setg(begin, begin, begin + size);
+            }
+    };
 }
 
 void Map::LoadMap(std::string path, int sizeX, int sizeY) {
-    char c;
-    std::fstream mapFile;
-    mapFile.open(path);
-    
+    if (LoadData(path, sizeX, sizeY)) {
+        BakeChunks();
+    }
+}
+
+bool Map::LoadData(const std::string& path, int sizeX, int sizeY) {
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    const char* format = "binary";
+    std::string binaryPath = path.substr(0, path.find_last_of('.')) + ".mapb";
+    if (!LoadBinaryMap(binaryPath, sizeX, sizeY)) {
+        format = "text";
+        if (!LoadTextMap(path, sizeX, sizeY)) {
+            return false;
+        }
+    }
+
+    double loadMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+    MergeColliders();
+    std::cout << "Loaded " << path << " (" << format << ", " << loadMs << " ms): " << solidTiles
+              << " solid tiles merged into " << colliderRects.size() << " colliders" << std::endl;
+    return true;
+}
+
+bool Map::LoadBinaryMap(const std::string& path, int sizeX, int sizeY) {
+    std::size_t packedSize;
+    const Uint8* packed = Game::assets->GetArchive().Find(path, packedSize);
+    if (packed != nullptr) {
+        return ReadBinaryMap(packed, packedSize, path, sizeX, sizeY);
+    }
+
+    MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    return ReadBinaryMap(file.GetData(), file.GetSize(), path, sizeX, sizeY);
+}
+
+bool Map::ReadBinaryMap(const Uint8* bytes, std::size_t size, const std::string& path, int sizeX, int sizeY) {
+    const std::size_t headerSize = sizeof(binaryMagic) + sizeof(Uint32) + 2 * sizeof(Uint16);
+    std::size_t cells = static_cast<std::size_t>(sizeX) * sizeY;
+    std::size_t tilesSize = cells * sizeof(Uint16);
+    std::size_t collisionSize = (cells + 7) / 8;
+
+    Uint32 version = 0;
+    Uint16 width = 0;
+    Uint16 height = 0;
+    if (size >= headerSize) {
+        std::memcpy(&version, bytes + 4, sizeof(version));
+        std::memcpy(&width, bytes + 8, sizeof(width));
+        std::memcpy(&height, bytes + 10, sizeof(height));
+    }
+
+    if (size < headerSize + tilesSize + collisionSize || std::memcmp(bytes, binaryMagic, sizeof(binaryMagic)) != 0 ||
+        version != binaryVersion || width != sizeX || height != sizeY) {
+        std::cout << "Ignoring invalid binary map " << path << ", falling back to text" << std::endl;
+        return false;
+    }
+
+    mapWidth = sizeX;
+    mapHeight = sizeY;
+    tileIDs.resize(cells);
+    collisionGrid.resize(cells);
+    solidTiles = 0;
+
+    const Uint8* tiles = bytes + headerSize;
+    const Uint8* collision = tiles + tilesSize;
+    for (std::size_t i = 0; i < cells; i++) {
+        Uint16 tileId;
+        std::memcpy(&tileId, tiles + i * sizeof(Uint16), sizeof(tileId));
+        tileIDs[i] = tileId;
+
+        Uint8 solid = (collision[i / 8] >> (i % 8)) & 1;
+        collisionGrid[i] = solid;
+        solidTiles += solid;
+    }
+    return true;
+}
+
+bool Map::LoadTextMap(const std::string& path, int sizeX, int sizeY) {
+    std::size_t packedSize;
+    const Uint8* packed = Game::assets->GetArchive().Find(path, packedSize);
+    if (packed != nullptr) {
+        MemoryBuffer buffer(packed, packedSize);
+        std::istream mapFile(&buffer);
+        return ParseTextMap(mapFile, sizeX, sizeY);
+    }
+
+    std::ifstream mapFile(path);
     if (!mapFile.is_open()) {
         std::cout << "Failed to open map file: " << path << std::endl;
-        return;
+        return false;
     }
+    return ParseTextMap(mapFile, sizeX, sizeY);
+}
+
+bool Map::ParseTextMap(std::istream& mapFile, int sizeX, int sizeY) {
+    char c;
 
-    int srcX, srcY;
+    mapWidth = sizeX;
+    mapHeight = sizeY;
+    tileIDs.assign(sizeX * sizeY, 0);
+    collisionGrid.assign(sizeX * sizeY, 0);
+    solidTiles = 0;
 
     for(int y = 0; y < sizeY; y++) {
         for(int x = 0; x < sizeX; x++) {
             int tileId;
             mapFile >> tileId;
-            
-            srcY = (tileId / 10) * tileSize;
-            srcX = (tileId % 10) * tileSize;
-            
-            AddTile(srcX, srcY, x * scaledSize, y * scaledSize);
-            
-            if (mapFile.peek() == ',') 
+
+            tileIDs[y * sizeX + x] = tileId;
+
+            if (mapFile.peek() == ',')
                 mapFile.ignore(1, ',');
-            else if (mapFile.peek() == ';') 
+            else if (mapFile.peek() == ';')
                 mapFile.ignore(1, ';');
         }
-        
+
         if (mapFile.peek() == '\n' || mapFile.peek() == '\r') {
             while (mapFile.peek() == '\n' || mapFile.peek() == '\r') {
                 mapFile.ignore(1, mapFile.peek());
@@ -52,18 +161,315 @@ void Map::LoadMap(std::string path, int sizeX, int sizeY) {
         for(int x = 0; x < sizeX; x++) {
             mapFile.get(c);
             if(c == '1') {
-                auto& tcol(manager.addEntity());
-                tcol.addComponent<ColliderComponent>("terrain", x * scaledSize, y * scaledSize, scaledSize);
-                tcol.addGroup(Game::groupColliders);
+                collisionGrid[y * sizeX + x] = 1;
+                solidTiles++;
             }
             mapFile.ignore();
         }
     }
-    mapFile.close();
+    return true;
+}
+
+void Map::BakeChunks() {
+    DestroyChunks();
+
+    SDL_Texture* terrain = Game::assets->GetTexture(texID);
+    if (terrain == nullptr || mapWidth == 0 || mapHeight == 0) {
+        return;
+    }
+
+    for (int cy = 0; cy < mapHeight; cy += chunkTiles) {
+        for (int cx = 0; cx < mapWidth; cx += chunkTiles) {
+            MapChunk chunk;
+            chunk.firstX = cx;
+            chunk.firstY = cy;
+            chunk.tilesX = std::min(chunkTiles, mapWidth - cx);
+            chunk.tilesY = std::min(chunkTiles, mapHeight - cy);
+            chunk.bounds = { cx * scaledSize, cy * scaledSize, chunk.tilesX * scaledSize, chunk.tilesY * scaledSize };
+            chunk.texture = nullptr;
+
+            if (SDL_RenderTargetSupported(Game::renderer) == SDL_TRUE) {
+                // Chunks are baked at source resolution and scaled up when blitted.
+                chunk.texture = SDL_CreateTexture(Game::renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                  chunk.tilesX * tileSize, chunk.tilesY * tileSize);
+            }
+            if (chunk.texture != nullptr) {
+                SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+                BakeChunk(chunk, terrain);
+            }
+
+            chunks.push_back(chunk);
+        }
+    }
 }
 
-void Map::AddTile(int srcX, int srcY, int xpos, int ypos) {
-    auto& tile(manager.addEntity());
-    tile.addComponent<TileComponent>(srcX, srcY, xpos, ypos, tileSize, mapScale, texID);
-    tile.addGroup(Game::groupMap);
-}
\ No newline at end of file
+void Map::BakeChunk(MapChunk& chunk, SDL_Texture* terrain) {
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(Game::renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(Game::renderer, &r, &g, &b, &a);
+
+    SDL_SetRenderTarget(Game::renderer, chunk.texture);
+    SDL_SetRenderDrawColor(Game::renderer, 0, 0, 0, 0);
+    SDL_RenderClear(Game::renderer);
+    DrawChunkTiles(chunk, terrain, true);
+
+    SDL_SetRenderTarget(Game::renderer, previousTarget);
+    SDL_SetRenderDrawColor(Game::renderer, r, g, b, a);
+}
+
+bool Map::ApplyPatch(const std::string& path) {
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    std::size_t size;
+    const Uint8* bytes = Game::assets->GetArchive().Find(path, size);
+    MappedFile file;
+    if (bytes == nullptr) {
+        if (!file.Open(path)) {
+            std::cout << "Failed to open map patch: " << path << std::endl;
+            return false;
+        }
+        bytes = file.GetData();
+        size = file.GetSize();
+    }
+
+    if (!ReadPatch(bytes, size, path)) {
+        return false;
+    }
+
+    double patchMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    std::cout << "Applied " << path << " (" << patchMs << " ms): " << solidTiles
+              << " solid tiles merged into " << colliderRects.size() << " colliders" << std::endl;
+    return true;
+}
+
+bool Map::ReadPatch(const Uint8* bytes, std::size_t size, const std::string& path) {
+    const std::size_t headerSize = sizeof(patchMagic) + sizeof(Uint32) + 2 * sizeof(Uint16) + sizeof(Uint32);
+    const std::size_t recordSize = sizeof(Uint32) + sizeof(Uint16) + 2 * sizeof(Uint8);
+
+    Uint32 version = 0;
+    Uint16 width = 0;
+    Uint16 height = 0;
+    Uint32 count = 0;
+    if (size >= headerSize) {
+        std::memcpy(&version, bytes + 4, sizeof(version));
+        std::memcpy(&width, bytes + 8, sizeof(width));
+        std::memcpy(&height, bytes + 10, sizeof(height));
+        std::memcpy(&count, bytes + 12, sizeof(count));
+    }
+
+    if (size < headerSize || std::memcmp(bytes, patchMagic, sizeof(patchMagic)) != 0 || version != patchVersion ||
+        width != mapWidth || height != mapHeight || (size - headerSize) / recordSize < count) {
+        std::cout << "Ignoring invalid map patch " << path << std::endl;
+        return false;
+    }
+
+    // Validate every record before touching the map so a bad patch leaves it unchanged.
+    std::size_t cells = static_cast<std::size_t>(mapWidth) * mapHeight;
+    const Uint8* records = bytes + headerSize;
+    for (Uint32 i = 0; i < count; i++) {
+        Uint32 cell;
+        std::memcpy(&cell, records + i * recordSize, sizeof(cell));
+        if (cell >= cells) {
+            std::cout << "Ignoring invalid map patch " << path << ": cell " << cell << " is out of range" << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<bool> dirtyChunks(chunks.size(), false);
+    int chunksPerRow = (mapWidth + chunkTiles - 1) / chunkTiles;
+    bool collisionChanged = false;
+
+    for (Uint32 i = 0; i < count; i++) {
+        const Uint8* record = records + i * recordSize;
+        Uint32 cell;
+        Uint16 tileId;
+        std::memcpy(&cell, record, sizeof(cell));
+        std::memcpy(&tileId, record + sizeof(cell), sizeof(tileId));
+        Uint8 solid = record[sizeof(cell) + sizeof(tileId)] != 0 ? 1 : 0;
+
+        if (tileIDs[cell] != tileId) {
+            tileIDs[cell] = tileId;
+            std::size_t chunk = (cell / mapWidth / chunkTiles) * chunksPerRow + (cell % mapWidth) / chunkTiles;
+            if (chunk < dirtyChunks.size()) {
+                dirtyChunks[chunk] = true;
+            }
+        }
+        if (collisionGrid[cell] != solid) {
+            solidTiles += solid ? 1 : -1;
+            collisionGrid[cell] = solid;
+            collisionChanged = true;
+        }
+    }
+
+    if (collisionChanged) {
+        MergeColliders();
+    }
+
+    SDL_Texture* terrain = Game::assets->GetTexture(texID);
+    if (terrain != nullptr) {
+        for (std::size_t i = 0; i < chunks.size(); i++) {
+            if (dirtyChunks[i] && chunks[i].texture != nullptr) {
+                BakeChunk(chunks[i], terrain);
+            }
+        }
+    }
+    return true;
+}
+
+void Map::DrawMap() {
+    SDL_Texture* terrain = nullptr;
+
+    for (const auto& chunk : chunks) {
+        SDL_Rect dest = {
+            chunk.bounds.x - Game::camera.x,
+            chunk.bounds.y - Game::camera.y,
+            chunk.bounds.w,
+            chunk.bounds.h
+        };
+
+        if (dest.x >= Game::camera.w || dest.y >= Game::camera.h ||
+            dest.x + dest.w <= 0 || dest.y + dest.h <= 0) {
+            continue;
+        }
+
+        if (chunk.texture != nullptr) {
+            SDL_RenderCopy(Game::renderer, chunk.texture, nullptr, &dest);
+        } else {
+            if (terrain == nullptr) {
+                terrain = Game::assets->GetTexture(texID);
+            }
+            DrawChunkTiles(chunk, terrain, false);
+        }
+    }
+}
+
+void Map::DrawColliders() {
+    SDL_Texture* tex = Game::assets->GetTexture("collider");
+    if (tex == nullptr || mapWidth == 0 || mapHeight == 0) {
+        return;
+    }
+
+    SDL_Rect src = { 0, 0, 32, 32 };
+    for (const auto& rect : colliderRects) {
+        SDL_Rect dest = { rect.x - Game::camera.x, rect.y - Game::camera.y, rect.w, rect.h };
+        if (dest.x >= Game::camera.w || dest.y >= Game::camera.h ||
+            dest.x + dest.w <= 0 || dest.y + dest.h <= 0) {
+            continue;
+        }
+        TextureManager::Draw(tex, src, dest, SDL_FLIP_NONE);
+    }
+}
+
+bool Map::IsSolid(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0 || tileX >= mapWidth || tileY >= mapHeight) {
+        return false;
+    }
+    return collisionGrid[tileY * mapWidth + tileX] != 0;
+}
+
+void Map::QueryColliders(const SDL_Rect& area, std::vector<SDL_Rect>& results) {
+    results.clear();
+
+    if (mapWidth == 0 || mapHeight == 0 || area.x + area.w < 0 || area.y + area.h < 0) {
+        return;
+    }
+
+    int minX = std::max(0, area.x / scaledSize);
+    int minY = std::max(0, area.y / scaledSize);
+    int maxX = std::min(mapWidth - 1, (area.x + area.w) / scaledSize);
+    int maxY = std::min(mapHeight - 1, (area.y + area.h) / scaledSize);
+
+    queryIndices.clear();
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            cellsVisited++;
+            int index = cellColliders[y * mapWidth + x];
+            if (index >= 0 && std::find(queryIndices.begin(), queryIndices.end(), index) == queryIndices.end()) {
+                queryIndices.push_back(index);
+            }
+        }
+    }
+
+    // Merged rects are numbered in row-major order of their top-left tile, so sorting keeps resolution order stable.
+    std::sort(queryIndices.begin(), queryIndices.end());
+    for (int index : queryIndices) {
+        results.push_back(colliderRects[index]);
+    }
+}
+
+void Map::MergeColliders() {
+    colliderRects.clear();
+    cellColliders.assign(mapWidth * mapHeight, -1);
+
+    auto isFree = [this](int x, int y) {
+        int cell = y * mapWidth + x;
+        return collisionGrid[cell] != 0 && cellColliders[cell] < 0;
+    };
+
+    for (int y = 0; y < mapHeight; y++) {
+        for (int x = 0; x < mapWidth; x++) {
+            if (!isFree(x, y)) {
+                continue;
+            }
+
+            int w = 1;
+            while (x + w < mapWidth && isFree(x + w, y)) {
+                w++;
+            }
+
+            int h = 1;
+            bool rowFree = true;
+            while (y + h < mapHeight && rowFree) {
+                for (int i = 0; i < w; i++) {
+                    if (!isFree(x + i, y + h)) {
+                        rowFree = false;
+                        break;
+                    }
+                }
+                if (rowFree) {
+                    h++;
+                }
+            }
+
+            int index = static_cast<int>(colliderRects.size());
+            colliderRects.push_back({ x * scaledSize, y * scaledSize, w * scaledSize, h * scaledSize });
+            for (int yy = y; yy < y + h; yy++) {
+                for (int xx = x; xx < x + w; xx++) {
+                    cellColliders[yy * mapWidth + xx] = index;
+                }
+            }
+        }
+    }
+}
+
+void Map::DrawChunkTiles(const MapChunk& chunk, SDL_Texture* terrain, bool toTarget) {
+    for (int y = chunk.firstY; y < chunk.firstY + chunk.tilesY; y++) {
+        for (int x = chunk.firstX; x < chunk.firstX + chunk.tilesX; x++) {
+            int tileId = tileIDs[y * mapWidth + x];
+
+            SDL_Rect src = { (tileId % 10) * tileSize, (tileId / 10) * tileSize, tileSize, tileSize };
+            SDL_Rect dest;
+
+            if (toTarget) {
+                dest = { (x - chunk.firstX) * tileSize, (y - chunk.firstY) * tileSize, tileSize, tileSize };
+            } else {
+                dest = { x * scaledSize - Game::camera.x, y * scaledSize - Game::camera.y, scaledSize, scaledSize };
+                if (dest.x >= Game::camera.w || dest.y >= Game::camera.h ||
+                    dest.x + dest.w <= 0 || dest.y + dest.h <= 0) {
+                    continue;
+                }
+            }
+
+            TextureManager::Draw(terrain, src, dest, SDL_FLIP_NONE);
+        }
+    }
+}
+
+void Map::DestroyChunks() {
+    for (auto& chunk : chunks) {
+        if (chunk.texture != nullptr) {
+            SDL_DestroyTexture(chunk.texture);
+        }
+    }
+    chunks.clear();
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <istream>
+#include "SDL2/SDL.h"
 #include "ECS/ECS.hpp"
 
 class Map {
@@ -9,12 +12,65 @@ class Map {
         ~Map();
 
         void LoadMap(std::string path, int sizeX, int sizeY);
-        void AddTile(int srcX, int srcY, int xpos, int ypos);
+        // Reads tiles and collision and merges colliders without touching the renderer, so it can
+        // run on a worker thread; BakeChunks must follow on the render thread.
+        bool LoadData(const std::string& path, int sizeX, int sizeY);
+        void BakeChunks();
+        // Applies a .mapd patch from tools/diff_maps.cpp in place, rebaking only the chunks it touches.
+        bool ApplyPatch(const std::string& path);
+        void DrawMap();
+
+        void DrawColliders();
+
+        bool IsSolid(int tileX, int tileY) const;
+        void QueryColliders(const SDL_Rect& area, std::vector<SDL_Rect>& results);
+        int GetSolidTileCount() const { return solidTiles; }
+        int GetWidth() const { return mapWidth; }
+        int GetHeight() const { return mapHeight; }
+        // World-space extent of the loaded map in pixels.
+        SDL_Rect GetBounds() const { return { 0, 0, mapWidth * scaledSize, mapHeight * scaledSize }; }
+        int GetColliderCount() const { return static_cast<int>(colliderRects.size()); }
+
+        long long cellsVisited = 0;
 
     private:
+        struct MapChunk {
+            SDL_Texture* texture;
+            SDL_Rect bounds;
+            int firstX, firstY;
+            int tilesX, tilesY;
+        };
+
+        // Binary maps are written by tools/convert_maps.cpp, which documents the layout.
+        bool LoadBinaryMap(const std::string& path, int sizeX, int sizeY);
+        bool ReadBinaryMap(const Uint8* bytes, std::size_t size, const std::string& path, int sizeX, int sizeY);
+        bool LoadTextMap(const std::string& path, int sizeX, int sizeY);
+        bool ParseTextMap(std::istream& mapFile, int sizeX, int sizeY);
+        bool ReadPatch(const Uint8* bytes, std::size_t size, const std::string& path);
+        void BakeChunk(MapChunk& chunk, SDL_Texture* terrain);
+        void DrawChunkTiles(const MapChunk& chunk, SDL_Texture* terrain, bool toTarget);
+        void DestroyChunks();
+        void MergeColliders();
+
         std::string texID;
         int mapScale;
         int tileSize;
         int scaledSize;
         Manager& manager;
-};
\ No newline at end of file
+
+        int mapWidth = 0;
+        int mapHeight = 0;
+        std::vector<int> tileIDs;
+        std::vector<MapChunk> chunks;
+        std::vector<Uint8> collisionGrid;
+        std::vector<int> cellColliders;
+        std::vector<SDL_Rect> colliderRects;
+        std::vector<int> queryIndices;
+        int solidTiles = 0;
+
+        static const int chunkTiles = 16;
+        static const char binaryMagic[4];
+        static const Uint32 binaryVersion = 1;
+        static const char patchMagic[4];
+        static const Uint32 patchVersion = 1;
+};
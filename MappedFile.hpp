@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include "SDL2/SDL.h"
+
+// Read-only memory mapping of a whole file (MapViewOfFile on Windows, mmap elsewhere).
+class MappedFile {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return data != nullptr; }
+        const Uint8* GetData() const { return data; }
+        std::size_t GetSize() const { return size; }
+
+    private:
+        const Uint8* data = nullptr;
+        std::size_t size = 0;
+
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int fileDescriptor = -1;
+#endif
+};
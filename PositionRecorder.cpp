@@ -0,0 +1,143 @@
+#include "PositionRecorder.hpp"
+#include <iostream>
+#include <cstring>
+
+const char PositionRecorder::magic[4] = { 'J', 'E', 'P', '1' };
+
+PositionRecorder::PositionRecorder() {
+    current.reserve(chunkRecords);
+}
+
+PositionRecorder::~PositionRecorder() {
+    Close();
+}
+
+void PositionRecorder::Open(const std::string& path, bool append) {
+    Close();
+
+    bool hasHeader = false;
+    if (append) {
+        std::ifstream existing(path, std::ios::binary);
+        char header[sizeof(magic)];
+        hasHeader = existing.read(header, sizeof(header)) && std::memcmp(header, magic, sizeof(magic)) == 0;
+    }
+
+    // A file without our header is rewritten rather than appended to, so Load never sees mixed formats.
+    if (hasHeader) {
+        file.open(path, std::ios::binary | std::ios::app);
+    } else {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        file.write(magic, sizeof(magic));
+    }
+
+    if (!file.is_open()) {
+        std::cerr << "Failed to open position recording: " << path << std::endl;
+        return;
+    }
+
+    stopping = false;
+    writer = std::thread(&PositionRecorder::WriterLoop, this);
+}
+
+void PositionRecorder::Append(int x, int y, int level) {
+    if (!file.is_open()) {
+        return;
+    }
+
+    current.push_back({ static_cast<Sint16>(x), static_cast<Sint16>(y), static_cast<Uint16>(level) });
+    if (current.size() >= chunkRecords) {
+        Flush();
+    }
+}
+
+void PositionRecorder::Flush() {
+    if (current.empty() || !writer.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(current));
+    }
+    wake.notify_one();
+
+    current = std::vector<Record>();
+    current.reserve(chunkRecords);
+}
+
+void PositionRecorder::Sync() {
+    Flush();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return pending.empty() && !writing; });
+}
+
+void PositionRecorder::Close() {
+    if (!writer.joinable()) {
+        return;
+    }
+
+    Sync();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    file.close();
+}
+
+bool PositionRecorder::Load(const std::string& path, std::map<int, std::vector<Vector2D>>& positionsByLevel) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    std::streamoff size = in.tellg();
+    if (size < static_cast<std::streamoff>(sizeof(magic))) {
+        return false;
+    }
+
+    std::vector<char> data(static_cast<size_t>(size));
+    in.seekg(0);
+    in.read(data.data(), size);
+    if (!in || std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        return false;
+    }
+
+    size_t count = (data.size() - sizeof(magic)) / sizeof(Record);
+    const char* cursor = data.data() + sizeof(magic);
+    for (size_t i = 0; i < count; i++) {
+        Record record;
+        std::memcpy(&record, cursor + i * sizeof(Record), sizeof(Record));
+        positionsByLevel[record.level].push_back(Vector2D(record.x, record.y));
+    }
+    return true;
+}
+
+void PositionRecorder::WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !pending.empty(); });
+
+        if (pending.empty()) {
+            return;
+        }
+
+        std::vector<Record> chunk = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+
+        lock.unlock();
+        file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(Record));
+        file.flush();
+        lock.lock();
+
+        recordsWritten += chunk.size();
+        writing = false;
+        if (pending.empty()) {
+            idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "SDL2/SDL.h"
+#include "Vector2D.hpp"
+
+class PositionRecorder {
+    public:
+        struct Record {
+            Sint16 x;
+            Sint16 y;
+            Uint16 level;
+        };
+
+        PositionRecorder();
+        ~PositionRecorder();
+
+        void Open(const std::string& path, bool append);
+        void Append(int x, int y, int level);
+        void Flush();
+        void Sync();
+        void Close();
+
+        static bool Load(const std::string& path, std::map<int, std::vector<Vector2D>>& positionsByLevel);
+
+        long long recordsWritten = 0;
+
+    private:
+        void WriterLoop();
+
+        static const char magic[4];
+        static const size_t chunkRecords = 4096;
+
+        std::ofstream file;
+        std::vector<Record> current;
+        std::deque<std::vector<Record>> pending;
+
+        std::thread writer;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        bool stopping = false;
+        bool writing = false;
+};
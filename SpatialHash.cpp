@@ -0,0 +1,75 @@
+#include "SpatialHash.hpp"
+#include "Collision.hpp"
+#include <algorithm>
+
+SpatialHash::SpatialHash(int size) : cellSize(size) {}
+
+void SpatialHash::clear() {
+    items.clear();
+    for (auto& cell : cells) {
+        cell.second.clear();
+    }
+}
+
+void SpatialHash::insert(Entity* entity, const SDL_Rect& bounds) {
+    int index = static_cast<int>(items.size());
+    items.push_back({ entity, bounds, currentStamp });
+
+    int minX = cellCoord(bounds.x);
+    int minY = cellCoord(bounds.y);
+    int maxX = cellCoord(bounds.x + bounds.w);
+    int maxY = cellCoord(bounds.y + bounds.h);
+
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            cells[cellKey(cx, cy)].push_back(index);
+        }
+    }
+}
+
+void SpatialHash::query(const SDL_Rect& area, std::vector<Entity*>& results) {
+    results.clear();
+    candidates.clear();
+    currentStamp++;
+
+    int minX = cellCoord(area.x);
+    int minY = cellCoord(area.y);
+    int maxX = cellCoord(area.x + area.w);
+    int maxY = cellCoord(area.y + area.h);
+
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) {
+                continue;
+            }
+
+            for (int index : it->second) {
+                Item& item = items[index];
+                if (item.queryStamp == currentStamp) {
+                    continue;
+                }
+                item.queryStamp = currentStamp;
+                testsPerformed++;
+
+                if (Collision::AABB(item.bounds, area)) {
+                    candidates.push_back(index);
+                }
+            }
+        }
+    }
+
+    // Keep results in insertion order so callers resolve overlaps in the same order as a linear scan.
+    std::sort(candidates.begin(), candidates.end());
+    for (int index : candidates) {
+        results.push_back(items[index].entity);
+    }
+}
+
+long long SpatialHash::cellKey(int cellX, int cellY) const {
+    return (static_cast<long long>(cellX) << 32) ^ static_cast<unsigned int>(cellY);
+}
+
+int SpatialHash::cellCoord(int value) const {
+    return value >= 0 ? value / cellSize : (value - cellSize + 1) / cellSize;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "SDL2/SDL.h"
+
+class Entity;
+
+class SpatialHash {
+    public:
+        SpatialHash(int cellSize);
+
+        void clear();
+        void insert(Entity* entity, const SDL_Rect& bounds);
+        void query(const SDL_Rect& area, std::vector<Entity*>& results);
+
+        int size() const { return static_cast<int>(items.size()); }
+
+        long long testsPerformed = 0;
+
+    private:
+        struct Item {
+            Entity* entity;
+            SDL_Rect bounds;
+            unsigned int queryStamp;
+        };
+
+        long long cellKey(int cellX, int cellY) const;
+        int cellCoord(int value) const;
+
+        int cellSize;
+        unsigned int currentStamp = 0;
+        std::vector<Item> items;
+        std::vector<int> candidates;
+        std::unordered_map<long long, std::vector<int>> cells;
+};
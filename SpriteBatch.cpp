@@ -0,0 +1,112 @@
+#include "SpriteBatch.hpp"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+void SpriteBatch::Begin() {
+    quads.clear();
+    recording = true;
+    layer = 0;
+    stats = Stats();
+}
+
+void SpriteBatch::NextLayer() {
+    layer++;
+}
+
+void SpriteBatch::Add(SDL_Texture* tex, const SDL_Rect& src, const SDL_Rect& dest, SDL_RendererFlip flip, Uint8 alpha) {
+    if (tex == nullptr || alpha == 0) {
+        return;
+    }
+    quads.push_back({ tex, layer, static_cast<int>(quads.size()), src, dest, flip, alpha });
+}
+
+void SpriteBatch::AddOverlay(SDL_Texture* tex, const SDL_Rect& src, const SDL_Rect& dest) {
+    if (tex == nullptr) {
+        return;
+    }
+    quads.push_back({ tex, overlayLayer, static_cast<int>(quads.size()), src, dest, SDL_FLIP_NONE, 255 });
+}
+
+void SpriteBatch::Flush(SDL_Renderer* renderer) {
+    recording = false;
+    if (quads.empty()) {
+        return;
+    }
+
+    std::sort(quads.begin(), quads.end(), [](const Quad& a, const Quad& b) {
+        if (a.layer != b.layer) {
+            return a.layer < b.layer;
+        }
+        if (a.texture != b.texture) {
+            return std::less<SDL_Texture*>()(a.texture, b.texture);
+        }
+        return a.order < b.order;
+    });
+
+    SDL_Texture* current = nullptr;
+    int texWidth = 1;
+    int texHeight = 1;
+    bool translucent = false;
+
+    for (const Quad& quad : quads) {
+        if (quad.texture != current) {
+            Submit(renderer, current, translucent);
+            current = quad.texture;
+            translucent = false;
+            SDL_QueryTexture(current, nullptr, nullptr, &texWidth, &texHeight);
+        }
+
+        float u0 = static_cast<float>(quad.src.x) / texWidth;
+        float v0 = static_cast<float>(quad.src.y) / texHeight;
+        float u1 = static_cast<float>(quad.src.x + quad.src.w) / texWidth;
+        float v1 = static_cast<float>(quad.src.y + quad.src.h) / texHeight;
+        if (quad.flip & SDL_FLIP_HORIZONTAL) {
+            std::swap(u0, u1);
+        }
+        if (quad.flip & SDL_FLIP_VERTICAL) {
+            std::swap(v0, v1);
+        }
+
+        float x0 = static_cast<float>(quad.dest.x);
+        float y0 = static_cast<float>(quad.dest.y);
+        float x1 = static_cast<float>(quad.dest.x + quad.dest.w);
+        float y1 = static_cast<float>(quad.dest.y + quad.dest.h);
+        SDL_Color color = { 255, 255, 255, quad.alpha };
+        translucent = translucent || quad.alpha < 255;
+
+        int base = static_cast<int>(vertices.size());
+        vertices.push_back({ { x0, y0 }, color, { u0, v0 } });
+        vertices.push_back({ { x1, y0 }, color, { u1, v0 } });
+        vertices.push_back({ { x1, y1 }, color, { u1, v1 } });
+        vertices.push_back({ { x0, y1 }, color, { u0, v1 } });
+        indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+    Submit(renderer, current, translucent);
+
+    stats.quads += static_cast<int>(quads.size());
+    quads.clear();
+}
+
+void SpriteBatch::Submit(SDL_Renderer* renderer, SDL_Texture* texture, bool translucent) {
+    if (texture == nullptr || vertices.empty()) {
+        return;
+    }
+
+    // Vertex alpha only shows through blending, matching TextureManager::Draw with an alpha.
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    SDL_GetTextureBlendMode(texture, &blendMode);
+    if (translucent && blendMode != SDL_BLENDMODE_BLEND) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+    stats.drawCalls++;
+
+    if (translucent && blendMode != SDL_BLENDMODE_BLEND) {
+        SDL_SetTextureBlendMode(texture, blendMode);
+    }
+    vertices.clear();
+    indices.clear();
+}
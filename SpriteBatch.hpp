@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include "SDL2/SDL.h"
+
+// Collects a frame's sprite quads and submits each run of quads sharing a texture with one
+// SDL_RenderGeometry call. Quads are ordered by layer, then texture, then submission order, so a
+// later layer always draws over an earlier one.
+class SpriteBatch {
+    public:
+        struct Stats {
+            int quads = 0;
+            int drawCalls = 0;
+        };
+
+        void Begin();
+        void NextLayer();
+        void Add(SDL_Texture* tex, const SDL_Rect& src, const SDL_Rect& dest, SDL_RendererFlip flip, Uint8 alpha = 255);
+        // Debug overlays draw above every layer regardless of when they are added.
+        void AddOverlay(SDL_Texture* tex, const SDL_Rect& src, const SDL_Rect& dest);
+        void Flush(SDL_Renderer* renderer);
+
+        bool IsRecording() const { return recording; }
+        const Stats& GetStats() const { return stats; }
+
+    private:
+        struct Quad {
+            SDL_Texture* texture;
+            int layer;
+            int order;
+            SDL_Rect src;
+            SDL_Rect dest;
+            SDL_RendererFlip flip;
+            Uint8 alpha;
+        };
+
+        void Submit(SDL_Renderer* renderer, SDL_Texture* texture, bool translucent);
+
+        static const int overlayLayer = 0x7fffffff;
+
+        std::vector<Quad> quads;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        bool recording = false;
+        int layer = 0;
+        Stats stats;
+};
@@ -0,0 +1,126 @@
+#include "TextureAtlas.hpp"
+#include "TextureManager.hpp"
+#include <algorithm>
+#include <iostream>
+
+TextureAtlas::TextureAtlas(int pageSize) : pageSize(pageSize) {}
+
+TextureAtlas::~TextureAtlas() {
+    for (auto& sheet : pending) {
+        SDL_FreeSurface(sheet.surface);
+    }
+    pending.clear();
+
+    for (auto& page : pages) {
+        if (page != nullptr) {
+            SDL_DestroyTexture(page);
+        }
+    }
+    pages.clear();
+}
+
+void TextureAtlas::Add(const std::string& id, SDL_Surface* surface) {
+    if (surface == nullptr) {
+        return;
+    }
+    pending.push_back({ id, surface, 0, { 0, 0, surface->w, surface->h } });
+}
+
+bool TextureAtlas::Find(const std::string& id, Region& region) const {
+    auto it = regions.find(id);
+    if (it == regions.end()) {
+        return false;
+    }
+    region = it->second;
+    return true;
+}
+
+void TextureAtlas::Build() {
+    if (pending.empty()) {
+        return;
+    }
+
+    std::vector<PendingSheet*> sheets;
+    for (auto& sheet : pending) {
+        sheets.push_back(&sheet);
+    }
+    std::vector<SDL_Point> pageSizes;
+    Pack(sheets, pageSizes);
+
+    int firstPage = static_cast<int>(pages.size());
+    std::vector<SDL_Surface*> surfaces;
+    for (const auto& size : pageSizes) {
+        surfaces.push_back(SDL_CreateRGBSurfaceWithFormat(0, size.x, size.y, 32, SDL_PIXELFORMAT_RGBA32));
+    }
+
+    for (auto& sheet : pending) {
+        SDL_Surface* page = surfaces[sheet.page];
+        if (page != nullptr) {
+            // Copy the sheet's alpha as-is instead of blending it onto the empty page.
+            SDL_SetSurfaceBlendMode(sheet.surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(sheet.surface, nullptr, page, &sheet.rect);
+        }
+        SDL_FreeSurface(sheet.surface);
+    }
+
+    for (std::size_t i = 0; i < surfaces.size(); i++) {
+        pages.push_back(surfaces[i] != nullptr ? TextureManager::UploadSurface(surfaces[i]) : nullptr);
+        std::cout << "Atlas page " << firstPage + i << ": " << pageSizes[i].x << "x" << pageSizes[i].y << std::endl;
+    }
+    for (const auto& sheet : pending) {
+        regions[sheet.id] = { pages[firstPage + sheet.page], sheet.rect };
+    }
+
+    std::cout << "Packed " << pending.size() << " sprite sheets into " << surfaces.size() << " atlas page(s)" << std::endl;
+    pending.clear();
+}
+
+void TextureAtlas::Pack(std::vector<PendingSheet*>& sheets, std::vector<SDL_Point>& pageSizes) const {
+    std::stable_sort(sheets.begin(), sheets.end(), [](const PendingSheet* a, const PendingSheet* b) {
+        return a->rect.h > b->rect.h;
+    });
+
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+
+    for (PendingSheet* sheet : sheets) {
+        int w = sheet->rect.w;
+        int h = sheet->rect.h;
+
+        // A sheet bigger than a page gets a page of its own size.
+        if (w > pageSize || h > pageSize) {
+            sheet->page = static_cast<int>(pageSizes.size());
+            sheet->rect.x = 0;
+            sheet->rect.y = 0;
+            pageSizes.push_back({ w, h });
+            continue;
+        }
+
+        if (pageSizes.empty() || pageSizes.back().x > pageSize || pageSizes.back().y > pageSize) {
+            pageSizes.push_back({ 0, 0 });
+            shelfX = shelfY = shelfHeight = 0;
+        }
+
+        if (shelfX + w > pageSize) {
+            shelfY += shelfHeight + padding;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (shelfY + h > pageSize) {
+            pageSizes.push_back({ 0, 0 });
+            shelfX = shelfY = shelfHeight = 0;
+        }
+
+        sheet->page = static_cast<int>(pageSizes.size()) - 1;
+        sheet->rect.x = shelfX;
+        sheet->rect.y = shelfY;
+
+        SDL_Point& size = pageSizes.back();
+        size.x = std::max(size.x, shelfX + w);
+        size.y = std::max(size.y, shelfY + h);
+
+        shelfX += w + padding;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include "SDL2/SDL.h"
+
+// Packs decoded sprite sheets into shared texture pages so sprites that use different sheets can
+// still be drawn from the same texture. Surfaces are added as they finish decoding and Build
+// uploads the pages, which must happen on the render thread.
+class TextureAtlas {
+    public:
+        struct Region {
+            SDL_Texture* texture;
+            SDL_Rect rect;
+        };
+
+        TextureAtlas(int pageSize);
+        ~TextureAtlas();
+
+        // Takes ownership of the surface.
+        void Add(const std::string& id, SDL_Surface* surface);
+        void Build();
+
+        bool HasPending() const { return !pending.empty(); }
+        bool Find(const std::string& id, Region& region) const;
+        int GetPageCount() const { return static_cast<int>(pages.size()); }
+        SDL_Texture* GetPage(int index) const { return pages[index]; }
+
+    private:
+        struct PendingSheet {
+            std::string id;
+            SDL_Surface* surface;
+            int page;
+            SDL_Rect rect;
+        };
+
+        // Shelf packing: sheets sorted tallest first fill rows left to right, and a sheet that
+        // would run off the bottom of the page starts a new page.
+        void Pack(std::vector<PendingSheet*>& sheets, std::vector<SDL_Point>& pageSizes) const;
+
+        static const int padding = 1;
+
+        int pageSize;
+        std::vector<PendingSheet> pending;
+        std::vector<SDL_Texture*> pages;
+        std::map<std::string, Region> regions;
+};
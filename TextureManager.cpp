@@ -1,9 +1,12 @@
 #include "TextureManager.hpp"
 
 SDL_Texture* TextureManager::LoadTexture(const char* texture) {
-    SDL_Surface* tempSurface = IMG_Load(texture);
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(Game::renderer, tempSurface);
-    SDL_FreeSurface(tempSurface);
+    return UploadSurface(IMG_Load(texture));
+}
+
+SDL_Texture* TextureManager::UploadSurface(SDL_Surface* surface) {
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(Game::renderer, surface);
+    SDL_FreeSurface(surface);
 
     return tex;
 }
@@ -6,6 +6,7 @@ class TextureManager {
     
     public:
         static SDL_Texture* LoadTexture(const char* filename);
+        static SDL_Texture* UploadSurface(SDL_Surface* surface);
         static void Draw(SDL_Texture* tex, SDL_Rect src, SDL_Rect dest, SDL_RendererFlip flip);
         static void Draw(SDL_Texture* tex, SDL_Rect src, SDL_Rect dest, SDL_RendererFlip flip, Uint8 alpha);
 };
\ No newline at end of file
@@ -22,8 +22,9 @@ void TransitionManager::init(Game* game, Manager* manager) {
     mManager = manager;
     
     if (mTransitionLabel == nullptr && mManager != nullptr) {
-        mTransitionLabel = &mManager->addEntity();
-        mTransitionLabel->addComponent<UILabel>(0, 0, "", "font2", mWhite);
+        Entity& label = mManager->addEntity();
+        label.addComponent<UILabel>(0, 0, "", "font2", mWhite);
+        mTransitionLabel = &label;
     }
 }
 
@@ -36,13 +37,13 @@ void TransitionManager::startTransition(int currentLevel, int nextLevel) {
     levelMessage << "Level " << nextLevel;
     mLevelTransitionText = levelMessage.str();
     
-    if (mTransitionLabel != nullptr) {
-        mTransitionLabel->getComponent<UILabel>().SetLabelText(mLevelTransitionText, "font2", mWhite);
-        int textWidth = mTransitionLabel->getComponent<UILabel>().GetWidth();
-        int textHeight = mTransitionLabel->getComponent<UILabel>().GetHeight();
-        int xPos = (1920 - textWidth) / 2;
-        int yPos = (1080 - textHeight) / 2;
-        mTransitionLabel->getComponent<UILabel>().SetPosition(xPos, yPos);
+    Entity* label = mTransitionLabel;
+    if (label != nullptr) {
+        UILabel& text = label->getComponent<UILabel>();
+        text.SetLabelText(mLevelTransitionText, "font2", mWhite);
+        int xPos = (1920 - text.GetWidth()) / 2;
+        int yPos = (1080 - text.GetHeight()) / 2;
+        text.SetPosition(xPos, yPos);
     }
 }
 
@@ -70,8 +71,9 @@ bool TransitionManager::updateTransition() {
         if (elapsedTime >= mFadeInOutDuration) {
             mIsTransitioning = false;
             
-            if (mTransitionLabel != nullptr) {
-                mTransitionLabel->getComponent<UILabel>().SetLabelText("", "font2");
+            Entity* label = mTransitionLabel;
+            if (label != nullptr) {
+                label->getComponent<UILabel>().SetLabelText("", "font2");
             }
             
             return true;
@@ -109,8 +111,9 @@ void TransitionManager::renderTransition() {
     SDL_Rect fullScreen = {0, 0, 1920, 1080};
     SDL_RenderFillRect(Game::renderer, &fullScreen);
     
-    if (mTransitionState >= 1 && mTransitionLabel != nullptr) {
-        mTransitionLabel->draw();
+    Entity* label = mTransitionLabel;
+    if (mTransitionState >= 1 && label != nullptr) {
+        label->draw();
     }
     
     SDL_SetRenderDrawColor(Game::renderer, 255, 255, 255, 255);
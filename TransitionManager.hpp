@@ -22,7 +22,7 @@ public:
     
     bool isTransitioning() const { return mIsTransitioning; }
     
-    Entity* mTransitionLabel;
+    EntityRef mTransitionLabel;
     
 private:
     bool mIsTransitioning;
@@ -4,27 +4,43 @@ Game *game = nullptr;
 
 int main(int argc, char* argv[]) {
 
-    const int FPS = 60;
-    const int frameDelay = 1000 / FPS;
-
-    Uint32 frameStart; 
-    int frameTime;
+    const int maxTicksPerFrame = 5;
+    const Uint32 minFrameMs = 1000 / 240;
 
     game = new Game();
     game->init("Johnny english", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1920, 1080, false);
 
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    Uint64 previous = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
+
     while(game->running()) {
 
-        frameStart = SDL_GetTicks();
+        Uint32 frameStart = SDL_GetTicks();
+        Uint64 now = SDL_GetPerformanceCounter();
+        accumulator += (now - previous) / frequency;
+        previous = now;
 
         game->handleEvents();
-        game->update();
-        game->render();
 
-        frameTime = SDL_GetTicks() - frameStart;
+        int ticks = 0;
+        while (accumulator >= Game::fixedTimestep && ticks < maxTicksPerFrame) {
+            game->update();
+            accumulator -= Game::fixedTimestep;
+            ticks++;
+        }
+
+        // Under sustained load, drop the backlog so the game slows down instead of spiralling.
+        if (ticks == maxTicksPerFrame && accumulator >= Game::fixedTimestep) {
+            accumulator = 0.0;
+        }
+
+        Game::renderAlpha = static_cast<float>(accumulator / Game::fixedTimestep);
+        game->render();
 
-        if(frameDelay > frameTime){
-            SDL_Delay(frameDelay - frameTime);
+        Uint32 frameTime = SDL_GetTicks() - frameStart;
+        if(minFrameMs > frameTime){
+            SDL_Delay(minFrameMs - frameTime);
         }
     }
 
@@ -0,0 +1,174 @@
+// Headless sprite rendering benchmark: draws the same scene with one SDL_RenderCopyEx per sprite
+// and through SpriteBatch, on a software renderer backed by an offscreen surface.
+// Usage: bench_sprites [sprites] [frames]     (run from the repository root so assets/ resolves)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_image.h"
+#include "../SpriteBatch.hpp"
+
+namespace {
+    struct SpriteTexture {
+        const char* path;
+        int frameSize;
+        int weight;
+        SDL_Texture* texture;
+    };
+
+    struct Sprite {
+        int texture;
+        int layer;
+        SDL_Rect src;
+        SDL_Rect dest;
+        SDL_RendererFlip flip;
+        Uint8 alpha;
+    };
+
+    // Layers follow Game::renderFrame: objects, NPCs, players, projectiles, enemies.
+    SpriteTexture textures[] = {
+        { "./assets/objects/clue.png", 32, 1, nullptr },
+        { "./assets/objects/magazine.png", 32, 2, nullptr },
+        { "./assets/objects/healthpotion.png", 32, 2, nullptr },
+        { "./assets/entities/scientistanimations.png", 32, 1, nullptr },
+        { "./assets/entities/playeranimations.png", 32, 1, nullptr },
+        { "./assets/projectiles/bulletHorizontal.png", 32, 4, nullptr },
+        { "./assets/projectiles/bulletVertical.png", 32, 4, nullptr },
+        { "./assets/entities/enemyanimations.png", 32, 10, nullptr },
+        { "./assets/entities/finalbossanimations.png", 32, 1, nullptr },
+    };
+    const int textureLayers[] = { 0, 0, 0, 1, 2, 3, 3, 4, 4 };
+    const int textureCount = sizeof(textures) / sizeof(textures[0]);
+
+    std::vector<Sprite> buildScene(int count) {
+        int totalWeight = 0;
+        for (const auto& t : textures) {
+            totalWeight += t.weight;
+        }
+
+        std::srand(1234);
+        std::vector<Sprite> sprites;
+        for (int i = 0; i < count; i++) {
+            int pick = std::rand() % totalWeight;
+            int index = 0;
+            while (pick >= textures[index].weight) {
+                pick -= textures[index].weight;
+                index++;
+            }
+
+            int texWidth = 0;
+            int texHeight = 0;
+            SDL_QueryTexture(textures[index].texture, nullptr, nullptr, &texWidth, &texHeight);
+            int size = textures[index].frameSize;
+            int columns = std::max(1, texWidth / size);
+            int rows = std::max(1, texHeight / size);
+
+            Sprite sprite;
+            sprite.texture = index;
+            sprite.layer = textureLayers[index];
+            sprite.src = { (std::rand() % columns) * size, (std::rand() % rows) * size, size, size };
+            sprite.dest = { std::rand() % (1920 - size * 3), std::rand() % (1080 - size * 3), size * 3, size * 3 };
+            sprite.flip = (std::rand() % 2) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+            sprite.alpha = index == 0 ? static_cast<Uint8>(std::rand() % 256) : 255;
+            sprites.push_back(sprite);
+        }
+
+        // The game submits sprites group by group, in entity order within a group.
+        std::stable_sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+            return a.layer < b.layer;
+        });
+        return sprites;
+    }
+
+    std::vector<Uint32> capture(SDL_Surface* target) {
+        const Uint32* pixels = static_cast<const Uint32*>(target->pixels);
+        return std::vector<Uint32>(pixels, pixels + target->w * target->h);
+    }
+
+    double toMs(Uint64 ticks) {
+        return ticks * 1000.0 / SDL_GetPerformanceFrequency();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int spriteCount = argc > 1 ? std::atoi(argv[1]) : 500;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+
+    if (SDL_Init(0) != 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        std::printf("SDL init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, 1920, 1080, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = target != nullptr ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (renderer == nullptr) {
+        std::printf("Could not create software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    for (auto& t : textures) {
+        SDL_Surface* surface = IMG_Load(t.path);
+        if (surface == nullptr) {
+            std::printf("Could not load %s: %s\n", t.path, IMG_GetError());
+            return 1;
+        }
+        t.texture = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_FreeSurface(surface);
+    }
+
+    std::vector<Sprite> sprites = buildScene(spriteCount);
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; frame++) {
+        SDL_RenderClear(renderer);
+        for (const auto& sprite : sprites) {
+            SDL_Texture* tex = textures[sprite.texture].texture;
+            SDL_SetTextureAlphaMod(tex, sprite.alpha);
+            SDL_RenderCopyEx(renderer, tex, &sprite.src, &sprite.dest, 0, NULL, sprite.flip);
+            SDL_SetTextureAlphaMod(tex, 255);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    double immediateMs = toMs(SDL_GetPerformanceCounter() - start) / frames;
+    std::vector<Uint32> immediateFrame = capture(target);
+
+    SpriteBatch batch;
+    start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; frame++) {
+        SDL_RenderClear(renderer);
+        batch.Begin();
+        int layer = 0;
+        for (const auto& sprite : sprites) {
+            while (layer < sprite.layer) {
+                batch.NextLayer();
+                layer++;
+            }
+            batch.Add(textures[sprite.texture].texture, sprite.src, sprite.dest, sprite.flip, sprite.alpha);
+        }
+        batch.Flush(renderer);
+        SDL_RenderPresent(renderer);
+    }
+    double batchedMs = toMs(SDL_GetPerformanceCounter() - start) / frames;
+    std::vector<Uint32> batchedFrame = capture(target);
+
+    int differing = 0;
+    for (std::size_t i = 0; i < immediateFrame.size(); i++) {
+        differing += immediateFrame[i] != batchedFrame[i];
+    }
+
+    std::printf("%d sprites, %d textures, %d frames on the software renderer\n", spriteCount, textureCount, frames);
+    std::printf("  RenderCopyEx: %d draw calls, %.3f ms/frame\n", spriteCount, immediateMs);
+    std::printf("  SpriteBatch:  %d draw calls, %.3f ms/frame\n", batch.GetStats().drawCalls, batchedMs);
+    std::printf("  %d of %d pixels differ between the two final frames\n", differing, static_cast<int>(immediateFrame.size()));
+
+    for (auto& t : textures) {
+        SDL_DestroyTexture(t.texture);
+    }
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    IMG_Quit();
+    SDL_Quit();
+    return 0;
+}
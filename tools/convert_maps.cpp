@@ -0,0 +1,111 @@
+// Converts text .map files into the binary .mapb format loaded by Map::LoadMap.
+// Usage: convert_maps <width> <height> <file.map>...
+// Each input is written next to itself with a .mapb extension.
+//
+// Layout (little-endian):
+//   char[4] "JEMB", Uint32 version, Uint16 width, Uint16 height
+//   Uint16 tiles[width * height]                  row-major tile indices
+//   Uint8 collision[(width * height + 7) / 8]     row-major bitset, bit (i % 8) of byte i / 8
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    const char magic[4] = { 'J', 'E', 'M', 'B' };
+    const std::uint32_t version = 1;
+
+    // Mirrors the text parser in Map.cpp so both formats produce the same level.
+    bool parseTextMap(const std::string& path, int width, int height,
+                      std::vector<std::uint16_t>& tiles, std::vector<std::uint8_t>& collision) {
+        std::ifstream mapFile(path);
+        if (!mapFile.is_open()) {
+            std::cerr << "Failed to open map file: " << path << std::endl;
+            return false;
+        }
+
+        tiles.assign(width * height, 0);
+        collision.assign((width * height + 7) / 8, 0);
+
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int tileId;
+                mapFile >> tileId;
+                if (tileId < 0 || tileId > 0xFFFF) {
+                    std::cerr << path << ": tile " << tileId << " at " << x << "," << y << " is out of range" << std::endl;
+                    return false;
+                }
+                tiles[y * width + x] = static_cast<std::uint16_t>(tileId);
+
+                if (mapFile.peek() == ',')
+                    mapFile.ignore(1, ',');
+                else if (mapFile.peek() == ';')
+                    mapFile.ignore(1, ';');
+            }
+
+            while (mapFile.peek() == '\n' || mapFile.peek() == '\r') {
+                mapFile.ignore(1, mapFile.peek());
+            }
+        }
+
+        char c;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                mapFile.get(c);
+                if (c == '1') {
+                    int cell = y * width + x;
+                    collision[cell / 8] |= static_cast<std::uint8_t>(1u << (cell % 8));
+                }
+                mapFile.ignore();
+            }
+        }
+        return true;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "Usage: convert_maps <width> <height> <file.map>..." << std::endl;
+        return 1;
+    }
+
+    int width = std::stoi(argv[1]);
+    int height = std::stoi(argv[2]);
+    if (width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF) {
+        std::cerr << "Invalid map size " << width << "x" << height << std::endl;
+        return 1;
+    }
+
+    for (int i = 3; i < argc; i++) {
+        std::string input = argv[i];
+        std::vector<std::uint16_t> tiles;
+        std::vector<std::uint8_t> collision;
+        if (!parseTextMap(input, width, height, tiles, collision)) {
+            return 1;
+        }
+
+        std::string output = input.substr(0, input.find_last_of('.')) + ".mapb";
+        std::ofstream out(output, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Could not open " << output << " for writing" << std::endl;
+            return 1;
+        }
+
+        out.write(magic, sizeof(magic));
+        writeValue(out, version);
+        writeValue(out, static_cast<std::uint16_t>(width));
+        writeValue(out, static_cast<std::uint16_t>(height));
+        out.write(reinterpret_cast<const char*>(tiles.data()), tiles.size() * sizeof(std::uint16_t));
+        out.write(reinterpret_cast<const char*>(collision.data()), collision.size());
+
+        std::cout << input << " -> " << output << " (" << out.tellp() << " bytes)" << std::endl;
+    }
+    return 0;
+}
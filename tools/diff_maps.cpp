@@ -0,0 +1,115 @@
+// Writes the cells that differ between two binary maps as a patch applied by Map::ApplyPatch.
+// Usage: diff_maps <before.mapb> <after.mapb> <output.mapd>
+// Both inputs come from convert_maps, so run that first.
+//
+// Layout (little-endian):
+//   char[4] "JEMD", Uint32 version, Uint16 width, Uint16 height, Uint32 count
+//   count x { Uint32 cell, Uint16 tile, Uint8 solid, Uint8 padding }   cell = y * width + x, ascending
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+    const char mapMagic[4] = { 'J', 'E', 'M', 'B' };
+    const std::uint32_t mapVersion = 1;
+    const char patchMagic[4] = { 'J', 'E', 'M', 'D' };
+    const std::uint32_t patchVersion = 1;
+
+    struct BinaryMap {
+        std::uint16_t width = 0;
+        std::uint16_t height = 0;
+        std::vector<std::uint16_t> tiles;
+        std::vector<std::uint8_t> solid;
+    };
+
+    bool readBinaryMap(const std::string& path, BinaryMap& map) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Failed to open map file: " << path << std::endl;
+            return false;
+        }
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        const std::size_t headerSize = sizeof(mapMagic) + sizeof(std::uint32_t) + 2 * sizeof(std::uint16_t);
+        std::uint32_t version = 0;
+        if (bytes.size() >= headerSize) {
+            std::memcpy(&version, bytes.data() + 4, sizeof(version));
+            std::memcpy(&map.width, bytes.data() + 8, sizeof(map.width));
+            std::memcpy(&map.height, bytes.data() + 10, sizeof(map.height));
+        }
+
+        std::size_t cells = static_cast<std::size_t>(map.width) * map.height;
+        if (bytes.size() < headerSize + cells * sizeof(std::uint16_t) + (cells + 7) / 8 ||
+            std::memcmp(bytes.data(), mapMagic, sizeof(mapMagic)) != 0 || version != mapVersion) {
+            std::cerr << path << " is not a valid binary map" << std::endl;
+            return false;
+        }
+
+        map.tiles.resize(cells);
+        std::memcpy(map.tiles.data(), bytes.data() + headerSize, cells * sizeof(std::uint16_t));
+
+        const char* collision = bytes.data() + headerSize + cells * sizeof(std::uint16_t);
+        map.solid.resize(cells);
+        for (std::size_t i = 0; i < cells; i++) {
+            map.solid[i] = (static_cast<std::uint8_t>(collision[i / 8]) >> (i % 8)) & 1;
+        }
+        return true;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        std::cerr << "Usage: diff_maps <before.mapb> <after.mapb> <output.mapd>" << std::endl;
+        return 1;
+    }
+
+    BinaryMap before;
+    BinaryMap after;
+    if (!readBinaryMap(argv[1], before) || !readBinaryMap(argv[2], after)) {
+        return 1;
+    }
+    if (before.width != after.width || before.height != after.height) {
+        std::cerr << "Map sizes differ: " << before.width << "x" << before.height << " vs "
+                  << after.width << "x" << after.height << std::endl;
+        return 1;
+    }
+
+    std::vector<std::uint32_t> changed;
+    for (std::size_t i = 0; i < before.tiles.size(); i++) {
+        if (before.tiles[i] != after.tiles[i] || before.solid[i] != after.solid[i]) {
+            changed.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    std::ofstream out(argv[3], std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Could not open " << argv[3] << " for writing" << std::endl;
+        return 1;
+    }
+
+    out.write(patchMagic, sizeof(patchMagic));
+    writeValue(out, patchVersion);
+    writeValue(out, after.width);
+    writeValue(out, after.height);
+    writeValue(out, static_cast<std::uint32_t>(changed.size()));
+    for (std::uint32_t cell : changed) {
+        writeValue(out, cell);
+        writeValue(out, after.tiles[cell]);
+        writeValue(out, after.solid[cell]);
+        writeValue(out, static_cast<std::uint8_t>(0));
+    }
+
+    std::cout << argv[1] << " -> " << argv[2] << ": " << changed.size() << " changed cells written to "
+              << argv[3] << " (" << out.tellp() << " bytes)" << std::endl;
+    return 0;
+}
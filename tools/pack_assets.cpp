@@ -0,0 +1,126 @@
+// Packs the game's read-only assets into a single archive read by AssetArchive.
+// Usage: pack_assets <assets directory> <output file>
+// Entry paths are stored relative to the parent of the assets directory ("assets/lvl1/..."),
+// matching the paths the game passes to AssetManager and Map.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char magic[4] = { 'J', 'E', 'P', 'K' };
+    const std::uint32_t version = 1;
+    const std::uint64_t alignment = 16;
+
+    // Save games, leaderboards and replays are written at runtime and stay loose.
+    const char* packedExtensions[] = { ".png", ".ttf", ".wav", ".mp3", ".ogg", ".map", ".mapb", ".mapd" };
+
+    struct PackEntry {
+        std::string path;
+        fs::path source;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    bool isPacked(const fs::path& file) {
+        std::string extension = file.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        for (const char* packed : packedExtensions) {
+            if (extension == packed) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    std::uint64_t alignUp(std::uint64_t value) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: pack_assets <assets directory> <output file>" << std::endl;
+        return 1;
+    }
+
+    fs::path root(argv[1]);
+    if (!fs::is_directory(root)) {
+        std::cerr << "Not a directory: " << root.string() << std::endl;
+        return 1;
+    }
+
+    std::vector<PackEntry> entries;
+    fs::path base = fs::absolute(root).parent_path();
+    for (const auto& item : fs::recursive_directory_iterator(root)) {
+        if (!item.is_regular_file() || !isPacked(item.path())) {
+            continue;
+        }
+        std::string path = fs::relative(fs::absolute(item.path()), base).generic_string();
+        entries.push_back({ path, item.path(), 0, static_cast<std::uint64_t>(item.file_size()) });
+    }
+
+    // Sorted so the same tree always produces the same archive.
+    std::sort(entries.begin(), entries.end(), [](const PackEntry& a, const PackEntry& b) {
+        return a.path < b.path;
+    });
+
+    std::uint64_t indexSize = sizeof(magic) + sizeof(version) + sizeof(std::uint32_t);
+    for (const auto& entry : entries) {
+        indexSize += sizeof(std::uint32_t) + entry.path.size() + 2 * sizeof(std::uint64_t);
+    }
+
+    std::uint64_t offset = alignUp(indexSize);
+    for (auto& entry : entries) {
+        entry.offset = offset;
+        offset = alignUp(offset + entry.size);
+    }
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Could not open " << argv[2] << " for writing" << std::endl;
+        return 1;
+    }
+
+    out.write(magic, sizeof(magic));
+    writeValue(out, version);
+    writeValue(out, static_cast<std::uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        writeValue(out, static_cast<std::uint32_t>(entry.path.size()));
+        out.write(entry.path.data(), entry.path.size());
+        writeValue(out, entry.offset);
+        writeValue(out, entry.size);
+    }
+
+    std::vector<char> buffer;
+    for (const auto& entry : entries) {
+        std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+        std::vector<char> padding(entry.offset - position, 0);
+        out.write(padding.data(), padding.size());
+
+        std::ifstream in(entry.source, std::ios::binary);
+        buffer.resize(entry.size);
+        if (!in.read(buffer.data(), buffer.size())) {
+            std::cerr << "Failed to read " << entry.source.string() << std::endl;
+            return 1;
+        }
+        out.write(buffer.data(), buffer.size());
+    }
+
+    std::uint64_t written = static_cast<std::uint64_t>(out.tellp());
+    out.close();
+    std::cout << "Packed " << entries.size() << " files into " << argv[2] << " (" << written << " bytes)" << std::endl;
+    return 0;
+}